@@ -22,9 +22,10 @@
 
 #include <util/common.hpp>
 
-template <typename value_type>
+// (text_type is a pointer to the text, see text_pointer_t)
+template <typename text_type>
 xssr_always_inline static std::pair<uint64_t, uint64_t>
-is_extended_lyndon_run(const value_type* text, const uint64_t n) {
+is_extended_lyndon_run(const text_type text, const uint64_t n) {
   std::pair<uint64_t, uint64_t> result = {0, 0};
   uint64_t i = 0;
   while (i < n) {
@@ -61,4 +62,26 @@ is_extended_lyndon_run(const value_type* text, const uint64_t n) {
   }
 
   return result;
-}
\ No newline at end of file
+}
+// duval's algorithm: reports the starting position of each factor of the
+// lyndon factorization of text[0, n) via callback(position), from left to right
+template <typename value_type, typename callback_type>
+static void lyndon_factorization(const value_type* text,
+                                 const uint64_t n,
+                                 callback_type&& callback) {
+  uint64_t i = 0;
+  while (i < n) {
+    uint64_t j = i + 1, k = i;
+    while (j < n && text[k] <= text[j]) {
+      if (text[k] < text[j])
+        k = i;
+      else
+        k++;
+      j++;
+    }
+    while (i <= k) {
+      callback(i);
+      i += j - k;
+    }
+  }
+}
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithms/xss_simple_ctx.hpp>
+#include <algorithms/xss_sparse_output.hpp>
 #include <data_structures/bit_vectors/bit_vector.hpp>
 #include <data_structures/stacks/naive_stack/naive_stack.hpp>
 #include <data_structures/stacks/telescope_stack/telescope_stack.hpp>
@@ -75,4 +76,53 @@ public:
     ctx.close();
     return result;
   }
+
+  // pss and nss of the sampled positions only (see xss_sparse_output.hpp);
+  // the stack still contains all open indices, but there is no bps
+  template <typename index_type = index_array, typename comparison_type>
+  static xss_sparse_result<index_type>
+  run_sparse_from_comparison(comparison_type& compare,
+                             const uint64_t n,
+                             const xss_sample& sample) {
+    using stack_type = telescope_stack<strategy, ctz_type>;
+
+    xss_sparse_result<index_type> result(sample.size(), n);
+    uint64_t next_slot = 0;
+    if (sample.size() > 0 && sample[0] == 0) {
+      result.set_pss(0, n);
+      result.set_nss(0, n - 1);
+      ++next_slot;
+    }
+
+    // (the stack always contains 0)
+    stack_type open_indices(n);
+    std::stack<uint64_t, std::vector<uint64_t>> open_slots;
+
+    // 1 to n-2
+    for (uint64_t i = 1; i < n - 1; ++i) {
+      while (compare(i, open_indices.top())) {
+        const uint64_t j = open_indices.top();
+        open_indices.pop();
+        if (!open_slots.empty() && sample[open_slots.top()] == j) {
+          result.set_nss(open_slots.top(), i);
+          open_slots.pop();
+        }
+      }
+      if (next_slot < sample.size() && sample[next_slot] == i) {
+        result.set_pss(next_slot, open_indices.top());
+        open_slots.push(next_slot++);
+      }
+      open_indices.push(i);
+    }
+
+    while (!open_slots.empty()) {
+      result.set_nss(open_slots.top(), n - 1);
+      open_slots.pop();
+    }
+    if (next_slot < sample.size() && sample[next_slot] == n - 1) {
+      result.set_pss(next_slot, n);
+      result.set_nss(next_slot, n);
+    }
+    return result;
+  }
 };
\ No newline at end of file
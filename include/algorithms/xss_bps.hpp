@@ -32,4 +32,13 @@ public:
     auto compare = lce_naive<value_type>::get_suffix_compare(text, n);
     return psv_simple<strategy, ctz_type>::run_from_comparison(compare, n);
   }
+
+  // pss and nss of the sampled positions only (see xss_sparse_output.hpp)
+  template <typename index_type = index_array, typename value_type>
+  static auto
+  run_sparse(const value_type* text, const uint64_t n, const xss_sample& sample) {
+    auto compare = lce_naive<value_type>::get_suffix_compare(text, n);
+    return psv_simple<strategy, ctz_type>::template run_sparse_from_comparison<
+        index_type>(compare, n, sample);
+  }
 };
\ No newline at end of file
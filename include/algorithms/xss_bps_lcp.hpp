@@ -23,12 +23,15 @@
 #include <algorithms/xss_real_ctx.hpp>
 #include <data_structures/bit_vectors/bit_vector.hpp>
 #include <data_structures/lce/lce_naive.hpp>
+#include <data_structures/packed_text.hpp>
 #include <sstream>
 #include <stack>
 #include <util/logging.hpp>
 
+// lce_type provides LCP values via get_lce(text, n)(i, j, known_lcp)
 template <stack_strategy strategy = DYNAMIC_BUFFERED,
-          typename ctz_type = ctz_builtin>
+          typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_naive>
 class xss_bps_lcp {
 public:
   template <typename value_type>
@@ -38,12 +41,21 @@ public:
                        : run_internal<false>(text, n, delta);
   }
 
+  // (see packed_text.hpp)
+  template <uint64_t bits>
+  static auto run_packed(const packed_text<bits>& text,
+                         const uint64_t delta = 4) {
+    return (delta > 0)
+               ? run_internal<true>(text.pointer(), text.size(), delta)
+               : run_internal<false>(text.pointer(), text.size(), delta);
+  }
+
 private:
-  template <bool use_delta_type, typename value_type>
+  template <bool use_delta_type, typename text_type>
   static auto
-  run_internal(const value_type* text, const uint64_t n, const uint64_t delta) {
-    // provides naively computed LCP values
-    const auto get_lcp = lce_naive<value_type>::get_lce(text);
+  run_internal(const text_type text, const uint64_t n, const uint64_t delta) {
+    using value_type = text_value_t<text_type>;
+    auto get_lcp = lce_type<value_type>::get_lce(text, n);
 
     using ctx_type = xss_real_ctx<strategy, ctz_type, use_delta_type,
                                   bit_vector, value_type>;
@@ -0,0 +1,142 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_simple_ctx.hpp>
+#include <data_structures/bit_vectors/bit_vector.hpp>
+#include <data_structures/bit_vectors/support/bps_support_sdsl.hpp>
+#include <type_traits>
+#include <vector>
+
+// true if the lce functor has capped(i, j, limit) (see lce_naive)
+template <typename lce_fn_type, typename = void>
+struct has_capped_lce : std::false_type {};
+
+template <typename lce_fn_type>
+struct has_capped_lce<lce_fn_type,
+                      std::void_t<decltype(std::declval<lce_fn_type&>().capped(
+                          uint64_t(), uint64_t(), uint64_t()))>>
+    : std::true_type {};
+
+// Lyndon arrays (and pss trees) of substrings text[l, r) of a text whose pss
+// tree and lce structure are already known, with 1 <= l < r <= n - 1.
+//
+// Let nss be the nss of the whole text. If nss[i] <= r, then the lyndon word
+// at i lies inside of the substring, so it is also the longest lyndon prefix
+// of text[i, r) (and the local nss of i is nss[i]). The remaining positions
+// are processed from right to left, following the local nss pointers. Two
+// suffixes i < j of the substring are compared with the lce limited to
+// r - j characters (a suffix that is a prefix of another one is smaller).
+// This takes O(r - l) lce and support queries. If the lce functor provides
+// capped(i, j, limit) (like lce_naive), the lce queries never read behind r,
+// so each of them compares at most r - l characters, no matter how long the
+// lces in the whole text are.
+//
+// support_type provides next_value(i) = nss[i] (e.g. bps_support_sdsl on the
+// bps of xss_real), lce_fn_type is the lce functor of the whole text (e.g.
+// lce_type<value_type>::get_lce(text, n)).
+template <typename value_type,
+          typename lce_fn_type,
+          typename support_type = bps_support_sdsl<bit_vector>>
+class xss_local_lyndon {
+private:
+  const value_type* text_;
+  lce_fn_type& lce_;
+  const support_type& support_;
+
+  // true if suffix j of text[l, r) is smaller than suffix i (with i < j)
+  xssr_always_inline bool
+  smaller(const uint64_t j, const uint64_t i, const uint64_t r) const {
+    uint64_t lcp;
+    if constexpr (has_capped_lce<lce_fn_type>::value)
+      lcp = lce_.capped(i, j, r - j);
+    else
+      lcp = lce_(i, j);
+    if (j + lcp >= r)
+      return true;
+    return text_[j + lcp] < text_[i + lcp];
+  }
+
+public:
+  xss_local_lyndon(const value_type* text,
+                   lce_fn_type& lce,
+                   const support_type& support)
+      : text_(text), lce_(lce), support_(support) {}
+
+  // local nss of the positions l, ..., r - 1 (as global positions, r if
+  // there is no smaller suffix in the substring)
+  template <typename index_type = uint32_t>
+  std::vector<index_type> nss(const uint64_t l, const uint64_t r) const {
+    std::vector<index_type> result(r - l);
+    index_type* local = result.data() - l;
+    local[r - 1] = r;
+    for (uint64_t i = r - 1; i-- > l;) {
+      const uint64_t global = support_.next_value(i);
+      if (global <= r) {
+        local[i] = global;
+        continue;
+      }
+      uint64_t j = i + 1;
+      while (j < r && !smaller(j, i, r))
+        j = local[j];
+      local[i] = j;
+    }
+    return result;
+  }
+
+  // lyndon array of text[l, r)
+  template <typename index_type = uint32_t>
+  std::vector<index_type> lyndon(const uint64_t l, const uint64_t r) const {
+    auto result = nss<index_type>(l, r);
+    for (uint64_t k = 0; k < result.size(); ++k)
+      result[k] -= l + k;
+    return result;
+  }
+
+  // bps of the pss tree of text[l, r) with sentinels, i.e. the result of
+  // xss_real on a copy of the substring with a sentinel on either side
+  bit_vector bps(const uint64_t l, const uint64_t r) const {
+    const uint64_t m = r - l + 2;
+    const auto local_nss = nss<uint64_t>(l, r);
+    bit_vector result(2 * m + 2, BV_FILL_ZERO);
+    xss_simple_ctx<bit_vector> ctx(result);
+    ctx.open();
+    ctx.open();
+
+    // (open nodes, as global positions)
+    std::vector<uint64_t> open_indices;
+    for (uint64_t i = l; i < r; ++i) {
+      while (!open_indices.empty() && local_nss[open_indices.back() - l] <= i) {
+        open_indices.pop_back();
+        ctx.close();
+      }
+      open_indices.push_back(i);
+      ctx.open();
+    }
+    for (uint64_t k = 0; k < open_indices.size(); ++k)
+      ctx.close();
+    ctx.close();
+    ctx.open();
+    ctx.close();
+    ctx.close();
+    return result;
+  }
+};
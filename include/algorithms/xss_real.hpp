@@ -21,56 +21,691 @@
 #pragma once
 
 #include <algorithms/duval.hpp>
+#include <algorithms/xss_real_checkpoint.hpp>
 #include <algorithms/xss_real_ctx.hpp>
+#include <algorithms/xss_real_stats.hpp>
+#include <algorithms/xss_sparse_output.hpp>
 #include <data_structures/bit_vectors/bit_vector.hpp>
+#include <data_structures/document_text.hpp>
+#include <data_structures/index_array.hpp>
 #include <data_structures/lce/lce_naive.hpp>
-#include <data_structures/stacks/telescope_stack/telescope_stack.hpp>
+#include <data_structures/packed_text.hpp>
+#include <omp.h>
+#include <optional>
 #include <sstream>
 #include <stack>
 #include <util/logging.hpp>
+#include <vector>
 
-struct {
-  uint64_t skipped_re = 0;
-  uint64_t skipped_al = 0;
-} xss_real_stats;
+// the bps of all texts of a batch, stored one after another
+// (the bps of text k consists of the bits [offsets[k], offsets[k + 1]))
+struct xss_batch_result {
+  bit_vector bps = bit_vector(0, BV_UNINITIALIZED);
+  std::vector<uint64_t> offsets;
+};
+
+// Decodes the children of node 0 from the words of a bps (in order). These
+// are the suffixes that are smaller than all preceding suffixes, i.e. the
+// starting positions of the factors of the lyndon factorization of
+// text[1, n - 1), which are reported via callback(position).
+template <typename callback_type>
+class xss_lyndon_decoder {
+private:
+  callback_type callback_;
+  const uint64_t n_;
+  // number of opening parentheses, and depth (the virtual root has depth 1)
+  uint64_t opens_;
+  int64_t excess_;
+
+public:
+  xss_lyndon_decoder(callback_type callback, const uint64_t n)
+      : callback_(callback), n_(n), opens_(0), excess_(0) {}
+
+  void operator()(const uint64_t* words, const uint64_t count) {
+    for (uint64_t w = 0; w < count; ++w) {
+      const uint64_t word = words[w];
+      const uint64_t ones = __builtin_popcountll(word);
+      // no child of node 0 can start within this word
+      if (excess_ > 66) {
+        opens_ += ones;
+        excess_ += 2 * (int64_t) ones - 64;
+        continue;
+      }
+      for (uint64_t k = 0; k < 64; ++k) {
+        if (word & (word_left_one >> k)) {
+          ++opens_;
+          if (++excess_ == 3) {
+            // (the k-th opening parenthesis belongs to node k - 2)
+            const uint64_t node = opens_ - 2;
+            if (node > 0 && node + 1 < n_)
+              callback_(node);
+          }
+        } else {
+          --excess_;
+        }
+      }
+    }
+  }
+};
+
+// lce_type provides LCP values via get_lce(text, n)(i, j, known_lcp)
+// stats_type is xss_no_stats or xss_stats (see xss_real_stats.hpp)
+// active_threshold is the minimal lcp that triggers run extension and
+// lookahead; it must be at least 128 (this way run extension extends at least
+// 64 bits of the bps)
+// prefetch_distance > 0 enables software prefetching: the lce scans of
+// lce_naive prefetch both streams prefetch_distance characters ahead (the
+// stack tops are not prefetched, since the next one is only known right
+// before its character is read)
+template <typename value_type,
+          typename ctz_type,
+          template <typename>
+          class lce_type>
+class xss_real_online;
+
+template <stack_strategy strategy, typename ctz_type>
+class xss_real_inplace;
 
 template <stack_strategy strategy = DYNAMIC_BUFFERED,
-          typename ctz_type = ctz_builtin>
+          typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_naive,
+          typename stats_type = xss_no_stats,
+          uint64_t active_threshold = 128,
+          uint64_t prefetch_distance = 0>
 class xss_real {
+  static_assert(active_threshold >= 128);
+
+  // (see xss_real_online.hpp)
+  template <typename, typename, template <typename> class>
+  friend class xss_real_online;
+  // (see xss_real_inplace.hpp)
+  template <stack_strategy, typename>
+  friend class xss_real_inplace;
+
 public:
-  template <bool stats = false, typename value_type>
+  template <typename value_type>
   static auto
   run(const value_type* text, const uint64_t n, const uint64_t delta = 4) {
-    return (delta > 0) ? run_internal<true, stats>(text, n, delta)
-                       : run_internal<false, stats>(text, n, delta);
+    return (delta > 0) ? run_internal<true>(text, n, delta)
+                       : run_internal<false>(text, n, delta);
+  }
+
+  // like run, but on a packed text (see packed_text.hpp); the lce of
+  // lce_naive then compares whole words
+  template <uint64_t bits>
+  static auto run_packed(const packed_text<bits>& text,
+                         const uint64_t delta = 4) {
+    return (delta > 0)
+               ? run_internal<true>(text.pointer(), text.size(), delta)
+               : run_internal<false>(text.pointer(), text.size(), delta);
+  }
+
+  // splits the text into one block per thread, builds the partial pss trees
+  // of the blocks in parallel and merges them at the block boundaries
+  template <typename value_type>
+  static auto run_parallel(const value_type* text,
+                           const uint64_t n,
+                           const uint64_t delta = 4,
+                           const uint64_t threads = omp_get_max_threads()) {
+    if (n < index32_limit) {
+      return (delta > 0) ? run_parallel_internal<true, uint32_t>(
+                               text, n, delta, threads)
+                         : run_parallel_internal<false, uint32_t>(
+                               text, n, delta, threads);
+    }
+    return (delta > 0)
+               ? run_parallel_internal<true, uint64_t>(text, n, delta, threads)
+               : run_parallel_internal<false, uint64_t>(text, n, delta,
+                                                        threads);
+  }
+
+  // like run, but writes a checkpoint to path after every interval text
+  // positions (see xss_real_checkpoint.hpp)
+  template <typename value_type>
+  static auto run_checkpointed(const value_type* text,
+                               const uint64_t n,
+                               const std::string& path,
+                               const uint64_t interval = 1ULL << 28,
+                               const uint64_t delta = 4) {
+    return run_checkpointed_internal(text, n, path, interval, delta, false);
+  }
+
+  // continues the construction from the last checkpoint in path (or starts
+  // from the beginning if there is no checkpoint of this text), and
+  // keeps writing checkpoints after every interval text positions
+  template <typename value_type>
+  static auto resume_checkpointed(const value_type* text,
+                                  const uint64_t n,
+                                  const std::string& path,
+                                  const uint64_t interval = 1ULL << 28,
+                                  const uint64_t delta = 4) {
+    return run_checkpointed_internal(text, n, path, interval, delta, true);
+  }
+
+  // like run, but with a fixed type of the indices and lcps on the stack
+  // (the other functions use uint32_t if n < 2^32, and uint64_t otherwise)
+  template <typename index_type, typename value_type>
+  static auto run_indexed(const value_type* text,
+                          const uint64_t n,
+                          const uint64_t delta = 4) {
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    if (delta > 0)
+      build_indexed<true, index_type>(text, n, delta, result);
+    else
+      build_indexed<false, index_type>(text, n, delta, result);
+    return result;
+  }
+
+  // writes the bps to the sink (see bps_stream.hpp) instead of returning it;
+  // only a window of window_words words of the bps is kept in memory
+  template <typename value_type, typename sink_type>
+  static void run_to_sink(const value_type* text,
+                          const uint64_t n,
+                          sink_type& sink,
+                          const uint64_t delta = 4,
+                          const uint64_t window_words =
+                              bps_stream<sink_type>::default_window_words) {
+    bps_stream<sink_type> result(2 * n + 2, sink, window_words);
+    if (delta > 0)
+      build<true>(text, n, delta, result);
+    else
+      build<false>(text, n, delta, result);
+  }
+
+  // reports the starting positions of the factors of the lyndon factorization
+  // of text[1, n - 1) via callback(position), from left to right; the bps is
+  // decoded while it leaves the window, so only the stacks and a window of
+  // window_words words of the bps are kept in memory (the older words are
+  // spilled to a temporary file, see bps_callback_sink)
+  template <typename value_type, typename callback_type>
+  static void run_lyndon_factorization(
+      const value_type* text,
+      const uint64_t n,
+      callback_type&& callback,
+      const uint64_t delta = 4,
+      const uint64_t window_words =
+          bps_stream<bps_file_sink>::default_window_words) {
+    xss_lyndon_decoder<callback_type&> decoder(callback, n);
+    const auto decode = [&](const uint64_t* words, const uint64_t count) {
+      decoder(words, count);
+    };
+    bps_callback_sink<decltype(decode)> sink(decode);
+    run_to_sink(text, n, sink, delta, window_words);
+  }
+
+  // pss and nss of the sampled positions only (e.g. xss_sample(n, k) for
+  // every k-th position); the bps is decoded while it leaves the window, so
+  // the output takes O(sample size) words instead of 2n bits (the entries are
+  // chosen like the ones of run_pss_array, see xss_sparse_result)
+  template <typename index_type = index_array, typename value_type>
+  static xss_sparse_result<index_type>
+  run_sparse(const value_type* text,
+             const uint64_t n,
+             const xss_sample& sample,
+             const uint64_t delta = 4,
+             const uint64_t window_words =
+                 bps_stream<bps_file_sink>::default_window_words) {
+    xss_sparse_result<index_type> result;
+    xss_sparse_decoder<telescope_stack<strategy, ctz_type>, index_type> decoder(
+        sample, n, result);
+    const auto decode = [&](const uint64_t* words, const uint64_t count) {
+      decoder(words, count);
+    };
+    bps_callback_sink<decltype(decode)> sink(decode);
+    run_to_sink(text, n, sink, delta, window_words);
+    return result;
+  }
+
+  // computes the pss array (pss[0] = pss[n - 1] = n); by default, the entries
+  // take 32 bits if n < 2^32 and 40 bits otherwise (see index_array.hpp), and
+  // any other index_type must be able to hold n (std::invalid_argument
+  // otherwise); the values are written while scanning, the bps is only kept
+  // for the lookahead
+  template <typename index_type = index_array, typename value_type>
+  static auto run_pss_array(const value_type* text,
+                            const uint64_t n,
+                            const uint64_t delta = 4) {
+    if constexpr (std::is_same<index_type, index_array>::value) {
+      if (index_array::is_wide(n))
+        return index_array(run_pss_array<uint40_t>(text, n, delta));
+      return index_array(run_pss_array<uint32_t>(text, n, delta));
+    } else {
+      check_index_type<index_type>(n);
+      std::vector<index_type> result(n);
+      bit_vector bps(2 * n + 2, BV_FILL_ZERO);
+      const xss_pss_array_output<index_type> output{result.data()};
+      if (delta > 0)
+        build<true>(text, n, delta, bps, output);
+      else
+        build<false>(text, n, delta, bps, output);
+      result[0] = n;
+      result[n - 1] = n;
+      return result;
+    }
+  }
+
+  // nss array (nss[0] = n - 1, nss[n - 1] = n)
+  template <typename index_type = index_array, typename value_type>
+  static auto run_nss_array(const value_type* text,
+                            const uint64_t n,
+                            const uint64_t delta = 4) {
+    if constexpr (std::is_same<index_type, index_array>::value) {
+      if (index_array::is_wide(n))
+        return index_array(run_nss_array<uint40_t>(text, n, delta));
+      return index_array(run_nss_array<uint32_t>(text, n, delta));
+    } else {
+      return nss_from_pss(run_pss_array<index_type>(text, n, delta));
+    }
+  }
+
+  // lyndon array (lyndon[i] = nss[i] - i)
+  template <typename index_type = index_array, typename value_type>
+  static auto run_lyndon_array(const value_type* text,
+                               const uint64_t n,
+                               const uint64_t delta = 4) {
+    if constexpr (std::is_same<index_type, index_array>::value) {
+      if (index_array::is_wide(n))
+        return index_array(run_lyndon_array<uint40_t>(text, n, delta));
+      return index_array(run_lyndon_array<uint32_t>(text, n, delta));
+    } else {
+      auto result = run_nss_array<index_type>(text, n, delta);
+      for (uint64_t i = 0; i < n; ++i) {
+        result[i] = result[i] - i;
+      }
+      return result;
+    }
+  }
+
+  // the nodes that are popped from the pss stack by node i are exactly the
+  // nodes on the path from i - 1 to pss[i] (excluding pss[i])
+  template <typename index_type>
+  static std::vector<index_type>
+  nss_from_pss(const std::vector<index_type>& pss) {
+    const uint64_t n = pss.size();
+    std::vector<index_type> nss(n);
+    for (uint64_t i = 1; i < n; ++i) {
+      const uint64_t pss_i = pss[i];
+      for (uint64_t j = i - 1; j != pss_i; j = pss[j]) {
+        nss[j] = i;
+      }
+    }
+    nss[n - 1] = n;
+    return nss;
+  }
+
+  // computes the bps of the pss tree, and then decodes the nss array from the
+  // bps (this is a second sequential pass over the bps, but there are no
+  // further character comparisons); the entries of the nss array are chosen
+  // like the ones of run_nss_array
+  template <typename index_type = index_array, typename value_type>
+  static auto run_with_nss(const value_type* text,
+                           const uint64_t n,
+                           const uint64_t delta = 4) {
+    check_index_type<index_type>(n);
+    auto bps = run(text, n, delta);
+    auto nss = nss_from_bps<index_type>(bps);
+    return std::make_pair(std::move(bps), std::move(nss));
+  }
+
+  // the nss of a node is the node that is opened next after its closing
+  // parenthesis; while a node is open, its entry of the result holds its
+  // parent (this way the result doubles as the stack of open nodes)
+  template <typename index_type = index_array>
+  static auto nss_from_bps(const bit_vector& bps) {
+    const uint64_t n = bps.size() / 2 - 1;
+    if constexpr (std::is_same<index_type, index_array>::value) {
+      if (index_array::is_wide(n))
+        return index_array(nss_from_bps<uint40_t>(bps));
+      return index_array(nss_from_bps<uint32_t>(bps));
+    } else {
+      check_index_type<index_type>(n);
+      std::vector<index_type> nss(n);
+      nss[0] = n;
+      uint64_t top = 0;
+      uint64_t next_node = 1;
+      uint64_t first_closed = 0;
+      uint64_t closed = 0;
+      const auto assign_closed = [&](const uint64_t value) {
+        for (uint64_t k = 0; k < closed; ++k) {
+          const uint64_t parent = nss[first_closed];
+          nss[first_closed] = value;
+          first_closed = parent;
+        }
+        closed = 0;
+      };
+
+      // skip the artificial root (and its closing parenthesis) and node 0
+      for (uint64_t k = 2; k < bps.size() - 1; ++k) {
+        if (bps[k]) {
+          assign_closed(next_node);
+          nss[next_node] = top;
+          top = next_node++;
+        } else {
+          if (closed++ == 0)
+            first_closed = top;
+          top = nss[top];
+        }
+      }
+      assign_closed(n);
+      return nss;
+    }
+  }
+
+  // computes the bps of many (short) texts at once; text k consists of the
+  // positions [offsets[k], offsets[k + 1]) of text (including both sentinels),
+  // each thread reuses one context (stack and bps buffer) for all its texts,
+  // which only grows when the thread gets a longer text
+  template <typename value_type>
+  static xss_batch_result
+  run_batch(const value_type* text,
+            const std::vector<uint64_t>& offsets,
+            const uint64_t delta = 4,
+            const uint64_t threads = omp_get_max_threads()) {
+    // (the indices on the stack are relative to the current text)
+    uint64_t max_n = 0;
+    for (uint64_t k = 1; k < offsets.size(); ++k) {
+      max_n = std::max(max_n, offsets[k] - offsets[k - 1]);
+    }
+    if (max_n < index32_limit) {
+      return (delta > 0) ? run_batch_internal<true, uint32_t>(text, offsets,
+                                                              delta, threads)
+                         : run_batch_internal<false, uint32_t>(text, offsets,
+                                                               delta, threads);
+    }
+    return (delta > 0) ? run_batch_internal<true, uint64_t>(text, offsets,
+                                                            delta, threads)
+                       : run_batch_internal<false, uint64_t>(text, offsets,
+                                                             delta, threads);
+  }
+
+  // like run_batch, but the documents are stored back to back without any
+  // sentinels or separators: document k consists of the positions
+  // [offsets[k], offsets[k + 1]) of text, and its sentinels are virtual (see
+  // document_text.hpp), such that the documents may contain any character and
+  // the text is never modified. the bps of a document of length m is the bps
+  // of the document with its sentinels (2m + 6 bits)
+  template <typename value_type>
+  static xss_batch_result
+  run_collection(const value_type* text,
+                 const std::vector<uint64_t>& offsets,
+                 const uint64_t delta = 4,
+                 const uint64_t threads = omp_get_max_threads()) {
+    uint64_t max_n = 0;
+    for (uint64_t k = 1; k < offsets.size(); ++k) {
+      max_n = std::max(max_n, offsets[k] - offsets[k - 1] + 2);
+    }
+    if (max_n < index32_limit) {
+      return (delta > 0)
+                 ? run_batch_internal<true, uint32_t, true>(text, offsets,
+                                                            delta, threads)
+                 : run_batch_internal<false, uint32_t, true>(text, offsets,
+                                                             delta, threads);
+    }
+    return (delta > 0) ? run_batch_internal<true, uint64_t, true>(
+                             text, offsets, delta, threads)
+                       : run_batch_internal<false, uint64_t, true>(
+                             text, offsets, delta, threads);
   }
 
 private:
-  template <bool use_delta_type, bool stats, typename value_type>
+  // texts shorter than this use 32 bit indices and lcps on the stack
+  constexpr static uint64_t index32_limit = 1ULL << 32;
+
+  template <bool use_delta_type,
+            typename index_type,
+            typename value_type,
+            typename bv_type = bit_vector,
+            typename output_type = xss_no_array_output>
+  using ctx_type = xss_real_ctx<strategy,
+                                ctz_type,
+                                use_delta_type,
+                                bv_type,
+                                value_type,
+                                output_type,
+                                stats_type,
+                                index_type>;
+
+  template <bool use_delta_type, typename text_type>
   static auto
-  run_internal(const value_type* text, const uint64_t n, const uint64_t delta) {
-    // provides naively computed LCP values
-    const auto get_lcp = lce_naive<value_type>::get_lce(text);
+  run_internal(const text_type text, const uint64_t n, const uint64_t delta) {
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    build<use_delta_type>(text, n, delta, result);
+    return result;
+  }
 
-    // active threshold must be at least 128
-    // (this way run extension extends at least 64 bits of the bps)
-    constexpr uint64_t active_threshold = 128;
+  template <bool use_delta_type,
+            typename text_type,
+            typename bv_type,
+            typename output_type = xss_no_array_output>
+  static void build(const text_type text,
+                    const uint64_t n,
+                    const uint64_t delta,
+                    bv_type& result,
+                    const output_type output = output_type()) {
+    if (n < index32_limit)
+      build_indexed<use_delta_type, uint32_t>(text, n, delta, result, output);
+    else
+      build_indexed<use_delta_type, uint64_t>(text, n, delta, result, output);
+  }
 
-    using ctx_type = xss_real_ctx<strategy, ctz_type, use_delta_type,
-                                  bit_vector, value_type>;
+  template <bool use_delta_type,
+            typename index_type,
+            typename text_type,
+            typename bv_type,
+            typename output_type = xss_no_array_output>
+  static void build_indexed(const text_type text,
+                            const uint64_t n,
+                            const uint64_t delta,
+                            bv_type& result,
+                            const output_type output = output_type()) {
+    using value_type = text_value_t<text_type>;
+    ctx_type<use_delta_type, index_type, value_type, bv_type, output_type> ctx(
+        text, result, delta, n, output);
+    if constexpr (stats_type::enabled) {
+      stats_type::local().reset();
+    }
+    build_with_ctx<false>(text, n, ctx);
+  }
 
-    bit_vector result(2 * n + 2, BV_FILL_ZERO);
-    ctx_type ctx(text, result, delta);
+  // (lce_naive with prefetching, see prefetch_distance)
+  template <typename text_type>
+  xssr_always_inline static auto get_lce(const text_type text,
+                                         const uint64_t n) {
+    using value_type = text_value_t<text_type>;
+    if constexpr (prefetch_distance > 0 &&
+                  std::is_same<lce_type<value_type>,
+                               lce_naive<value_type>>::value)
+      return lce_naive<value_type>::template get_lce_prefetch<
+          prefetch_distance>(text, n);
+    else
+      return lce_type<value_type>::get_lce(text, n);
+  }
+
+  // counts the lce calls and the characters covered by them
+  template <typename get_lcp_type>
+  struct counting_lce {
+    get_lcp_type& get_lcp_;
+
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           const uint64_t lcp) {
+      const uint64_t result = get_lcp_(i, j, lcp);
+      stats_type::local().lce(result - lcp + 1);
+      return result;
+    }
+  };
+
+  // if reusable, then the stack is popped down to the sentinel afterwards
+  // (this way the context can be reset for the next text of a batch)
+  template <bool reusable, typename text_type, typename ctx_type>
+  static void
+  build_with_ctx(const text_type text, const uint64_t n, ctx_type& ctx) {
     ctx.open();
     ctx.open();
 
-    if constexpr (stats) {
-      xss_real_stats.skipped_al = 0;
-      xss_real_stats.skipped_re = 0;
+    // 1 to n-2
+    auto get_lcp = get_lce(text, n);
+    if constexpr (stats_type::enabled) {
+      counting_lce<decltype(get_lcp)> get_lcp_counted{get_lcp};
+      scan(text, ctx, get_lcp_counted, 1, n - 1);
+    } else {
+      scan(text, ctx, get_lcp, 1, n - 1);
     }
+    finish_bps<reusable>(ctx);
+  }
 
-    // 1 to n-2
-    for (uint64_t i = 1; i < n - 1; ++i) {
+  // closes all nodes that are still open, and appends the bps of node n - 1
+  template <bool reusable, typename ctx_type>
+  static void finish_bps(ctx_type& ctx) {
+    if constexpr (reusable) {
+      while (ctx.top_idx() > 0) {
+        ctx.close();
+        ctx.pop_with_lcp();
+      }
+    } else if constexpr (strategy == DYNAMIC_BUFFERED) {
+      const uint64_t not_closed = ctx.size();
+      for (uint64_t i = 1; i < not_closed; ++i) {
+        ctx.close();
+      }
+    } else {
+      while (ctx.top_idx() > 0) {
+        ctx.close();
+        ctx.pop_without_lcp();
+      }
+    }
+    ctx.close();
+    ctx.open();
+    ctx.close();
+    ctx.close();
+    ctx.finish();
+  }
+
+  template <typename value_type>
+  static bit_vector run_checkpointed_internal(const value_type* text,
+                                              const uint64_t n,
+                                              const std::string& path,
+                                              const uint64_t interval,
+                                              const uint64_t delta,
+                                              const bool resume) {
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    xss_checkpoint_file checkpoint(path, resume);
+    if (n < index32_limit) {
+      if (delta > 0)
+        build_checkpointed<true, uint32_t>(text, n, delta, result, checkpoint,
+                                           interval, resume);
+      else
+        build_checkpointed<false, uint32_t>(text, n, delta, result,
+                                            checkpoint, interval, resume);
+    } else {
+      if (delta > 0)
+        build_checkpointed<true, uint64_t>(text, n, delta, result, checkpoint,
+                                           interval, resume);
+      else
+        build_checkpointed<false, uint64_t>(text, n, delta, result,
+                                            checkpoint, interval, resume);
+    }
+    return result;
+  }
+
+  // scans the text in chunks of interval positions, and saves a checkpoint
+  // after each chunk (the chunk boundaries do not change the result, since
+  // scan never skips beyond the end of its range)
+  template <bool use_delta_type, typename index_type, typename value_type>
+  static void build_checkpointed(const value_type* text,
+                                 const uint64_t n,
+                                 const uint64_t delta,
+                                 bit_vector& result,
+                                 xss_checkpoint_file& checkpoint,
+                                 const uint64_t interval,
+                                 const bool resume) {
+    ctx_type<use_delta_type, index_type, value_type> ctx(text, result, delta,
+                                                         n);
+    auto get_lcp = get_lce(text, n);
+
+    const uint64_t fingerprint = xss_checkpoint_file::fingerprint(text, n);
+    uint64_t i = 1;
+    xss_checkpoint_file::state state;
+    if (resume && checkpoint.load(n, fingerprint, result, state)) {
+      i = state.next_idx;
+      restore_stack<index_type>(ctx, get_lcp, n, state.length);
+    } else {
+      ctx.open();
+      ctx.open();
+    }
+
+    while (i < n - 1) {
+      const uint64_t to = std::min(n - 1, i + std::max<uint64_t>(interval, 1));
+      scan(text, ctx, get_lcp, i, to);
+      i = to;
+      checkpoint.save(n, fingerprint, i, result, ctx.current_length());
+    }
+    finish_bps<false>(ctx);
+  }
+
+  // rebuilds the stack from the first length bits of the bps: the stack
+  // contains exactly the nodes that are opened but not closed
+  template <typename index_type, typename ctx_type, typename get_lcp_type>
+  static void restore_stack(ctx_type& ctx,
+                            get_lcp_type& get_lcp,
+                            const uint64_t n,
+                            const uint64_t length) {
+    ctx.resume_at(length);
+    // (the first two bits open the virtual root and the sentinel)
+    uint64_t idx = 0;
+    for (uint64_t k = 2; k < length; ++k) {
+      if (ctx[k])
+        ctx.push_without_lcp(++idx);
+      else
+        ctx.pop_without_lcp();
+    }
+    telescope_stack<strategy, ctz_type, index_type> buffer_reverse(n);
+    restore_lcps(ctx, get_lcp, buffer_reverse, 0, n);
+  }
+
+  // pops all indices that were pushed without lcp (i.e. all indices above the
+  // topmost index with lcp), and pushes them again with lcp; buffer_reverse
+  // must be empty and able to hold values up to base (which must be larger
+  // than all popped indices)
+  template <typename ctx_type, typename get_lcp_type, typename buffer_type>
+  xssr_always_inline static void restore_lcps(ctx_type& ctx,
+                                              get_lcp_type& get_lcp,
+                                              buffer_type& buffer_reverse,
+                                              const uint64_t bottom,
+                                              const uint64_t base) {
+    const auto rev_transform = [&](const uint64_t idx) { return base - idx; };
+    while (ctx.top_idx() > bottom) {
+      buffer_reverse.push(rev_transform(ctx.top_idx()));
+      ctx.pop_without_lcp();
+    }
+
+    const uint64_t rev_stop = rev_transform(0);
+    const auto rev_top = [&]() { return rev_transform(buffer_reverse.top()); };
+
+    while (rev_top() != rev_stop) {
+      uint64_t lcp = get_lcp(ctx.top_idx(), rev_top(), 0);
+      uint64_t dist = rev_top() - ctx.top_idx();
+
+      ctx.push_with_lcp(rev_top(), lcp);
+      buffer_reverse.pop();
+
+      while (lcp >= dist && rev_top() != rev_stop &&
+             ((rev_top() - ctx.top_idx()) == dist)) {
+        lcp -= dist;
+        ctx.push_with_lcp(rev_top(), lcp);
+        buffer_reverse.pop();
+      }
+    }
+  }
+
+  // processes the text positions [from, to) on top of the current stack
+  // (run extension and lookahead never skip beyond position to - 1)
+  template <typename text_type, typename ctx_type, typename get_lcp_type>
+  xssr_always_inline static void scan(const text_type text,
+                                      ctx_type& ctx,
+                                      get_lcp_type& get_lcp,
+                                      const uint64_t from,
+                                      const uint64_t to) {
+    for (uint64_t i = from; i < to; ++i) {
 
       while (text[ctx.top_idx()] > text[i]) {
         ctx.pop_with_lcp();
@@ -113,15 +748,17 @@ private:
         // END RUN -- EXTEND RUN -- EXTEND RUN -- EXTEND RUN -- EXTEND RUN -- EX
         if (xssr_unlikely(gamma >= 2 * distance)) {
           const uint64_t period = distance;
-          const uint64_t repetitions = gamma / period - 1;
+          const uint64_t repetitions =
+              std::min(gamma / period - 1, (to - 1 - i) / period);
+          // (only a block end can cut the run below 64 bits of the bps)
+          if (xssr_unlikely(repetitions * (2 * period - 1) < 64)) {
+            continue;
+          }
           // INCREASING RUN
           if (suffix_j_smaller_i) {
             ctx.extend_increasing_run(period, repetitions);
-            for (uint64_t r = 0; r < repetitions; ++r) {
-              i += period;
-              gamma -= period;
-              ctx.push_with_lcp(i, gamma);
-            }
+            ctx.push_run(i + period, period, gamma - period, repetitions);
+            i += period * repetitions;
           }
           // DECREASING RUN
           else {
@@ -130,8 +767,8 @@ private:
             i += period * repetitions;
             ctx.push_without_lcp(i);
           }
-          if constexpr (stats) {
-            xss_real_stats.skipped_re += period * repetitions;
+          if constexpr (stats_type::enabled) {
+            stats_type::local().run_extension(period, period * repetitions);
           }
         }
 
@@ -142,9 +779,9 @@ private:
           uint64_t anchor = ell;
 
           // check if gamm_ell is an extended lyndon run
-          const auto gamma_str = &(text[i]);
+          const auto gamma_str = text + i;
           const auto duval =
-              is_extended_lyndon_run(&(gamma_str[ell]), gamma - ell);
+              is_extended_lyndon_run(gamma_str + ell, gamma - ell);
 
           // try to extend the lyndon run as far as possible to the left
           if (duval.first > 0) {
@@ -161,6 +798,7 @@ private:
             }
             anchor = std::min(ell, lhs + 2 * period);
           }
+          anchor = std::min(anchor, to - i);
 
           // find the opening parenthesis of node j
           const uint64_t j_bps_idx = (ctx.current_length() - 1) - 2 * distance +
@@ -180,63 +818,280 @@ private:
             ctx.open();
           }
 
-          // TODO: embedd in BPS
           // buffer all open indices on a stack (reverse the order)
-          telescope_stack<strategy, ctz_type> buffer_reverse(anchor);
-          const auto rev_transform = [&](const uint64_t idx) {
-            return i + anchor - idx;
-          };
-          while (ctx.top_idx() > i) {
-            buffer_reverse.push(rev_transform(ctx.top_idx()));
-            ctx.pop_without_lcp();
+          // and restore stack L
+          restore_lcps(ctx, get_lcp, ctx.reverse_stack(), i, i + anchor);
+
+          // continue with iteration i + anchor
+          i += anchor - 1;
+
+          if constexpr (stats_type::enabled) {
+            stats_type::local().lookahead(anchor - 1);
           }
+        }
+      }
+    }
+  }
 
-          const uint64_t rev_stop = rev_transform(0);
-          const auto rev_top = [&]() {
-            return rev_transform(buffer_reverse.top());
-          };
+  // ORs the bits [src_idx, src_idx + length) of src into the bits
+  // [dst_idx, dst_idx + length) of dst (words may be shared between threads)
+  xssr_always_inline static void or_bits_atomic(bit_vector& dst,
+                                                const uint64_t dst_idx,
+                                                const bit_vector& src,
+                                                const uint64_t src_idx,
+                                                const uint64_t length) {
+    uint64_t* data = dst.data();
+    for (uint64_t k = 0; k < length; k += 64) {
+      uint64_t word = src.get_word(src_idx + k);
+      if (length - k < 64) {
+        word &= word_all_one << (64 - (length - k));
+      }
+      const uint64_t bit_idx = mod64(dst_idx + k);
+      const uint64_t word_idx = div64(dst_idx + k);
+      __atomic_fetch_or(&data[word_idx], word >> bit_idx, __ATOMIC_RELAXED);
+      if (bit_idx > 0) {
+        __atomic_fetch_or(&data[word_idx + 1], word << (64 - bit_idx),
+                          __ATOMIC_RELAXED);
+      }
+    }
+  }
 
-          // restore stack L
-          while (rev_top() != rev_stop) {
-            uint64_t lcp = get_lcp(ctx.top_idx(), rev_top(), 0);
-            uint64_t dist = rev_top() - ctx.top_idx();
+  // document k of a batch (with its sentinels) or of a collection (whose
+  // sentinels are virtual)
+  template <bool virtual_sentinels, typename value_type>
+  xssr_always_inline static auto
+  get_document(const value_type* text,
+               const std::vector<uint64_t>& offsets,
+               const uint64_t k) {
+    const uint64_t n = offsets[k + 1] - offsets[k];
+    if constexpr (virtual_sentinels)
+      return document_text_pointer<value_type>(&(text[offsets[k]]), n + 2);
+    else
+      return &(text[offsets[k]]);
+  }
 
-            ctx.push_with_lcp(rev_top(), lcp);
-            buffer_reverse.pop();
+  template <bool use_delta_type,
+            typename index_type,
+            bool virtual_sentinels = false,
+            typename value_type>
+  static xss_batch_result
+  run_batch_internal(const value_type* text,
+                     const std::vector<uint64_t>& offsets,
+                     const uint64_t delta,
+                     const uint64_t threads) {
+    using doc_value_type = std::conditional_t<virtual_sentinels,
+                                              document_symbol<value_type>,
+                                              value_type>;
+    constexpr uint64_t sentinels = virtual_sentinels ? 2 : 0;
 
-            while (lcp >= dist && rev_top() != rev_stop &&
-                   ((rev_top() - ctx.top_idx()) == dist)) {
-              lcp -= dist;
-              ctx.push_with_lcp(rev_top(), lcp);
-              buffer_reverse.pop();
-            }
-          }
+    const uint64_t texts = (offsets.size() > 0) ? offsets.size() - 1 : 0;
+    xss_batch_result result;
+    result.offsets.resize(texts + 1);
+    result.offsets[0] = 0;
+    for (uint64_t k = 0; k < texts; ++k) {
+      const uint64_t n = offsets[k + 1] - offsets[k] + sentinels;
+      result.offsets[k + 1] = result.offsets[k] + 2 * n + 2;
+    }
+    result.bps = bit_vector(result.offsets[texts], BV_FILL_ZERO);
+    if (texts == 0) {
+      return result;
+    }
 
-          // continue with iteration i + anchor
-          i += anchor - 1;
+    // chunks of consecutive texts of similar total length (found on the
+    // offsets); a text that is longer than a chunk forms a chunk on its own
+    const uint64_t chunk_length =
+        std::max<uint64_t>((offsets[texts] - offsets[0]) / (16 * threads), 1);
+    std::vector<uint64_t> chunks = {0};
+    // (length of the longest text of each chunk)
+    std::vector<uint64_t> chunk_max_n;
+    while (chunks.back() < texts) {
+      const uint64_t first = chunks.back();
+      const auto bound =
+          std::upper_bound(offsets.begin() + first + 1,
+                           offsets.begin() + texts + 1,
+                           offsets[first] + chunk_length);
+      chunks.push_back(
+          std::max<uint64_t>(bound - offsets.begin() - 1, first + 1));
+      uint64_t chunk_n = 2;
+      for (uint64_t k = first; k < chunks.back(); ++k)
+        chunk_n = std::max(chunk_n, offsets[k + 1] - offsets[k] + sentinels);
+      chunk_max_n.push_back(chunk_n);
+    }
 
-          if constexpr (stats) {
-            xss_real_stats.skipped_al += anchor - 1;
-          }
+    using batch_ctx_type = ctx_type<use_delta_type, index_type, doc_value_type>;
+    stats_type total_stats;
+#pragma omp parallel num_threads(threads)
+    {
+      // the stack and the bps buffer are sized for the longest chunk that the
+      // thread has processed so far (and not for the longest text of the
+      // batch, which only the thread that builds it has to hold)
+      uint64_t capacity = 0;
+      bit_vector buffer(0, BV_FILL_ZERO);
+      std::optional<batch_ctx_type> ctx;
+      if constexpr (stats_type::enabled)
+        stats_type::local().reset();
+
+#pragma omp for schedule(dynamic, 1)
+      for (uint64_t c = 0; c < chunks.size() - 1; ++c) {
+        if (chunk_max_n[c] > capacity) {
+          capacity = chunk_max_n[c];
+          ctx.reset();
+          buffer = bit_vector(2 * capacity + 2, BV_FILL_ZERO);
+          ctx.emplace(get_document<virtual_sentinels>(text, offsets, 0),
+                      buffer, delta, capacity);
+        }
+        for (uint64_t k = chunks[c]; k < chunks[c + 1]; ++k) {
+          const auto doc = get_document<virtual_sentinels>(text, offsets, k);
+          const uint64_t n = offsets[k + 1] - offsets[k] + sentinels;
+          ctx->reset(doc, n);
+          build_with_ctx<true>(doc, n, *ctx);
+
+          const uint64_t length = 2 * n + 2;
+          or_bits_atomic(result.bps, result.offsets[k], buffer, 0, length);
+          memset(buffer.data(), 0,
+                 mul8(std::min(div64(length) + 2, buffer.data_size())));
         }
       }
+      if constexpr (stats_type::enabled) {
+#pragma omp critical
+        total_stats.merge(stats_type::local());
+      }
     }
+    if constexpr (stats_type::enabled)
+      stats_type::local() = total_stats;
+    return result;
+  }
 
-    if constexpr (strategy == DYNAMIC_BUFFERED) {
-      const uint64_t not_closed = ctx.size();
-      for (uint64_t i = 1; i < not_closed; ++i) {
-        ctx.close();
+  template <bool use_delta_type, typename index_type, typename value_type>
+  static auto run_parallel_internal(const value_type* text,
+                                    const uint64_t n,
+                                    const uint64_t delta,
+                                    const uint64_t threads) {
+    const uint64_t blocks = std::min(threads, n - 2);
+    if (blocks <= 1) {
+      bit_vector result(2 * n + 2, BV_FILL_ZERO);
+      build_indexed<use_delta_type, index_type>(text, n, delta, result);
+      return result;
+    }
+
+    // a node opens a block if its previous smaller suffix lies in an earlier
+    // block (these are the nodes that pop the sentinel of the block's stack)
+    struct block_type {
+      uint64_t from;
+      uint64_t to;
+      bit_vector bps = bit_vector(0, BV_UNINITIALIZED);
+      uint64_t bps_length;
+      std::vector<uint64_t> top_level_bps_idx;
+      std::vector<uint64_t> top_level_text_idx;
+      std::vector<uint64_t> top_level_closes;
+      std::vector<uint64_t> still_open;
+      uint64_t result_idx;
+    };
+    std::vector<block_type> block(blocks);
+    for (uint64_t b = 0; b < blocks; ++b) {
+      block[b].from = 1 + (b * (n - 2)) / blocks;
+      block[b].to = 1 + ((b + 1) * (n - 2)) / blocks;
+    }
+
+    // (the lce structure is shared by all threads)
+    auto get_lcp = get_lce(text, n);
+
+    // PARTIAL TREES -- PARTIAL TREES -- PARTIAL TREES -- PARTIAL TREES -- PART
+    stats_type total_stats;
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (uint64_t b = 0; b < blocks; ++b) {
+      auto& blk = block[b];
+      blk.bps = bit_vector(2 * (blk.to - blk.from) + 2, BV_FILL_ZERO);
+      if constexpr (stats_type::enabled)
+        stats_type::local().reset();
+
+      // the stack only contains the sentinel, which is smaller than all
+      // suffixes of the block (just like the real stack bottom)
+      ctx_type<use_delta_type, index_type, value_type> ctx(text, blk.bps, delta,
+                                                           n);
+      if constexpr (stats_type::enabled) {
+        counting_lce<decltype(get_lcp)> get_lcp_counted{get_lcp};
+        scan(text, ctx, get_lcp_counted, blk.from, blk.to);
+      } else {
+        scan(text, ctx, get_lcp, blk.from, blk.to);
       }
-    } else {
+      blk.bps_length = ctx.current_length();
       while (ctx.top_idx() > 0) {
-        ctx.close();
-        ctx.pop_without_lcp();
+        blk.still_open.push_back(ctx.top_idx());
+        ctx.pop_with_lcp();
+      }
+      std::reverse(blk.still_open.begin(), blk.still_open.end());
+      if constexpr (stats_type::enabled) {
+#pragma omp critical
+        total_stats.merge(stats_type::local());
+      }
+
+      // top level nodes are the opening parentheses at excess zero
+      uint64_t excess = 0;
+      uint64_t text_idx = blk.from;
+      for (uint64_t k = 0; k < blk.bps_length; ++k) {
+        if (blk.bps[k]) {
+          if (excess == 0) {
+            blk.top_level_bps_idx.push_back(k);
+            blk.top_level_text_idx.push_back(text_idx);
+          }
+          ++excess;
+          ++text_idx;
+        } else {
+          --excess;
+        }
       }
     }
-    ctx.close();
-    ctx.open();
-    ctx.close();
-    ctx.close();
+
+    if constexpr (stats_type::enabled)
+      stats_type::local() = total_stats;
+
+    // MERGE BOUNDARIES -- MERGE BOUNDARIES -- MERGE BOUNDARIES -- MERGE BOUNDA
+    const auto suffix_greater = [&](const uint64_t i, const uint64_t j) {
+      const uint64_t lcp = get_lcp(i, j, 0);
+      return text[i + lcp] > text[j + lcp];
+    };
+
+    std::vector<uint64_t> stack = {0};
+    uint64_t result_idx = 2;
+    for (auto& blk : block) {
+      blk.result_idx = result_idx;
+      for (const uint64_t idx : blk.top_level_text_idx) {
+        uint64_t closes = 0;
+        while (stack.back() > 0 && suffix_greater(stack.back(), idx)) {
+          stack.pop_back();
+          ++closes;
+        }
+        blk.top_level_closes.push_back(closes);
+        result_idx += closes;
+      }
+      stack.insert(stack.end(), blk.still_open.begin(), blk.still_open.end());
+      result_idx += blk.bps_length;
+    }
+
+    // ASSEMBLE BPS -- ASSEMBLE BPS -- ASSEMBLE BPS -- ASSEMBLE BPS -- ASSEMBLE
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    result.set_one(0);
+    result.set_one(1);
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (uint64_t b = 0; b < blocks; ++b) {
+      auto& blk = block[b];
+      const uint64_t top_level_nodes = blk.top_level_bps_idx.size();
+      uint64_t dst_idx = blk.result_idx;
+      for (uint64_t k = 0; k < top_level_nodes; ++k) {
+        const uint64_t src_idx = blk.top_level_bps_idx[k];
+        const uint64_t src_end = (k + 1 < top_level_nodes)
+                                     ? blk.top_level_bps_idx[k + 1]
+                                     : blk.bps_length;
+        dst_idx += blk.top_level_closes[k];
+        or_bits_atomic(result, dst_idx, blk.bps, src_idx, src_end - src_idx);
+        dst_idx += src_end - src_idx;
+      }
+    }
+
+    // close all remaining nodes but the root, then add the last sentinel
+    result_idx += stack.size();
+    result.set_one(result_idx);
     return result;
   }
-};
\ No newline at end of file
+};
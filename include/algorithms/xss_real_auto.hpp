@@ -0,0 +1,204 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_real.hpp>
+#include <array>
+#include <cmath>
+#include <data_structures/bit_vectors/bps_stream.hpp>
+#include <stdexcept>
+#include <string>
+
+// a stack strategy and parameter delta of xss_real, and whether the bps is
+// written to a file instead of being kept in memory
+struct xss_auto_config {
+  stack_strategy strategy;
+  uint64_t delta;
+  bool bps_on_disk;
+  // estimated peak memory of the construction (without the text)
+  uint64_t bytes;
+
+  std::string to_string() const {
+    return "strategy=" + std::to_string(strategy) +
+           " delta=" + std::to_string(delta) +
+           " bps_on_disk=" + std::to_string(bps_on_disk) +
+           " estimated_bytes=" + std::to_string(bytes);
+  }
+};
+
+struct xss_auto_result {
+  xss_auto_config config;
+  // empty if the bps was written to a file
+  bit_vector bps = bit_vector(0, BV_UNINITIALIZED);
+};
+
+// Chooses the stack strategy and delta of xss_real at runtime, such that the
+// estimated memory of the construction fits into a given budget (in bytes).
+// The estimates are worst case bounds: the indices and lcps of the naive
+// stack take 64n (or 128n if n >= 2^32) bits, the compressed stacks take n bits
+// for the indices and 4n / delta bits for the lcps.
+template <typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_naive>
+class xss_real_auto {
+private:
+  struct candidate {
+    stack_strategy strategy;
+    uint64_t delta;
+  };
+
+  // ordered from fastest to slowest (see --bench-stacks); larger values of
+  // delta need less memory, but more character comparisons
+  constexpr static std::array<candidate, 7> candidates = {
+      {{NAIVE, 0},
+       {DYNAMIC_BUFFERED, 4},
+       {DYNAMIC, 4},
+       {STATIC, 4},
+       {DYNAMIC, 16},
+       {STATIC, 16},
+       {STATIC, 64}}};
+
+  // blocks of the dynamic stacks, buffers, ...
+  constexpr static uint64_t overhead_bytes = 1ULL << 22;
+  constexpr static uint64_t window_words =
+      bps_stream<bps_file_sink>::default_window_words;
+
+  // (see lcp_stack_buffered and telescope_stack_buffered)
+  static uint64_t buffer_entries(const uint64_t words) {
+    return std::max(words, (uint64_t) 65536);
+  }
+
+public:
+  static uint64_t bps_bytes(const uint64_t n) {
+    return mul8(div64(2 * n + 2) + 2);
+  }
+
+  // the bps_stream keeps only the window (and a small cache) in memory
+  static uint64_t window_bytes() {
+    return mul8(window_words + 1024);
+  }
+
+  // worst case memory of the stacks, including the stack of the lookahead
+  static uint64_t stack_bytes(const stack_strategy strategy,
+                              const uint64_t delta,
+                              const uint64_t n) {
+    const uint64_t index_bytes = (n < (1ULL << 32)) ? 4 : 8;
+    const uint64_t reverse_n = div<4>(n) + 1;
+    if (strategy == NAIVE)
+      return index_bytes * (2 * n + reverse_n) + overhead_bytes;
+
+    // telescope stacks of the indices, and unary stack of the lcps (plus the
+    // types of the lcps if delta = 0)
+    uint64_t bits = (n + 65) + (reverse_n + 65);
+    if (n < 4096)
+      bits += 128 * n;
+    else if (delta == 0)
+      bits += 6 * n;
+    else
+      bits += (4 * n) >> (uint64_t) std::floor(std::log2(delta));
+    uint64_t bytes = div<8>(bits);
+    if (strategy != STATIC) {
+      // the dynamic telescope stacks store a jump for every gap of more than
+      // 128 between two consecutive indices
+      bytes += 2 * index_bytes * div<128>(n + reverse_n);
+    }
+    if (strategy == DYNAMIC_BUFFERED) {
+      bytes += 2 * index_bytes * buffer_entries(div<128>(n));
+      bytes += index_bytes * buffer_entries(div<64>(reverse_n));
+    }
+    return bytes + overhead_bytes;
+  }
+
+  // all configurations in the order in which they are considered
+  static std::vector<xss_auto_config> configs(const uint64_t n,
+                                              const bool bps_on_disk) {
+    std::vector<xss_auto_config> result;
+    const uint64_t bps = bps_on_disk ? window_bytes() : bps_bytes(n);
+    for (const auto& c : candidates) {
+      result.push_back({c.strategy, c.delta, bps_on_disk,
+                        bps + stack_bytes(c.strategy, c.delta, n)});
+    }
+    return result;
+  }
+
+  // the fastest configuration that fits into the budget; the bps is only
+  // written to a file if no configuration fits with the bps in memory
+  static xss_auto_config
+  choose(const uint64_t n, const uint64_t memory_budget, const bool allow_disk) {
+    for (const bool on_disk : {false, true}) {
+      if (on_disk && !allow_disk)
+        break;
+      for (const auto& config : configs(n, on_disk)) {
+        if (config.bytes <= memory_budget)
+          return config;
+      }
+    }
+    throw std::runtime_error(
+        "Memory budget of " + std::to_string(memory_budget) +
+        " bytes is too small for a text of length " + std::to_string(n) +
+        (allow_disk ? "." : " (without writing the bps to a file)."));
+  }
+
+  // if the bps does not fit into the budget, it is written to path (in the
+  // layout of bit_vector::data()), and the returned bps is empty
+  template <typename value_type>
+  static xss_auto_result run(const value_type* text,
+                             const uint64_t n,
+                             const uint64_t memory_budget,
+                             const std::string& path = "") {
+    return run_config(text, n,
+                      choose(n, memory_budget, path.size() > 0), path);
+  }
+
+  template <typename value_type>
+  static xss_auto_result run_config(const value_type* text,
+                                    const uint64_t n,
+                                    const xss_auto_config& config,
+                                    const std::string& path = "") {
+    switch (config.strategy) {
+    case NAIVE:
+      return run_with<NAIVE>(text, n, config, path);
+    case STATIC:
+      return run_with<STATIC>(text, n, config, path);
+    case DYNAMIC:
+      return run_with<DYNAMIC>(text, n, config, path);
+    default:
+      return run_with<DYNAMIC_BUFFERED>(text, n, config, path);
+    }
+  }
+
+private:
+  template <stack_strategy strategy, typename value_type>
+  static xss_auto_result run_with(const value_type* text,
+                                  const uint64_t n,
+                                  const xss_auto_config& config,
+                                  const std::string& path) {
+    using algo = xss_real<strategy, ctz_type, lce_type>;
+    xss_auto_result result;
+    result.config = config;
+    if (config.bps_on_disk) {
+      bps_file_sink sink(path);
+      algo::run_to_sink(text, n, sink, config.delta, window_words);
+    } else {
+      result.bps = algo::run(text, n, config.delta);
+    }
+    return result;
+  }
+};
@@ -0,0 +1,152 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <cstdio>
+#include <data_structures/bit_vectors/bit_vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <util/common.hpp>
+
+// Checkpoint of a (sequential) xss_real construction. The file consists of a
+// header (magic number, n, fingerprint of the text, next text position, bps
+// length, last partial word of the bps) followed by the complete words of the
+// bps prefix. The stack is not stored, since it can be rebuilt from the bps
+// prefix. The fingerprint covers the whole text and not only the processed
+// prefix, since the lces of the processed positions may read arbitrarily far
+// beyond it.
+// Words of the bps prefix never change, so each checkpoint only appends the
+// words completed since the previous one, and then overwrites the header (if
+// the process dies while writing, the previous header remains valid).
+class xss_checkpoint_file {
+private:
+  constexpr static uint64_t magic = 0x78737372636b7074ULL; // "xssrckpt"
+  constexpr static uint64_t header_words = 6;
+  constexpr static uint64_t prime = (1ULL << 61) - 1;
+  constexpr static uint64_t base = 0x1c3a5f2e9b47d6e1ULL % prime;
+
+  xssr_always_inline static uint64_t mul(const uint64_t a, const uint64_t b) {
+    const __uint128_t p = static_cast<__uint128_t>(a) * b;
+    const uint64_t r = (static_cast<uint64_t>(p) & prime) +
+                       static_cast<uint64_t>(p >> 61);
+    return (r >= prime) ? (r - prime) : r;
+  }
+
+  std::FILE* file_;
+  uint64_t words_written_;
+
+  void write_at(const uint64_t word_idx,
+                const uint64_t* words,
+                const uint64_t count) {
+    std::fseek(file_, mul8(word_idx), SEEK_SET);
+    if (std::fwrite(words, sizeof(uint64_t), count, file_) != count)
+      throw std::runtime_error("Could not write checkpoint.");
+  }
+
+  bool read_at(const uint64_t word_idx, uint64_t* words, const uint64_t count) {
+    std::fseek(file_, mul8(word_idx), SEEK_SET);
+    return std::fread(words, sizeof(uint64_t), count, file_) == count;
+  }
+
+public:
+  // the state that is needed to continue a construction
+  struct state {
+    uint64_t n;
+    uint64_t next_idx;
+    uint64_t length;
+  };
+
+  // if resume is set, an existing file is kept (otherwise it is truncated)
+  xss_checkpoint_file(const std::string& path, const bool resume)
+      : file_(resume ? std::fopen(path.c_str(), "r+b") : nullptr),
+        words_written_(0) {
+    if (file_ == nullptr)
+      file_ = std::fopen(path.c_str(), "w+b");
+    if (file_ == nullptr)
+      throw std::runtime_error("Could not open " + path + " for writing.");
+  }
+
+  ~xss_checkpoint_file() {
+    std::fclose(file_);
+  }
+
+  // karp-rabin fingerprint of text[0, n) modulo the mersenne prime 2^61 - 1
+  template <typename value_type>
+  static uint64_t fingerprint(const value_type* text, const uint64_t n) {
+    uint64_t result = n % prime;
+    for (uint64_t i = 0; i < n; ++i) {
+      const uint64_t r = mul(result, base) +
+                         static_cast<uint64_t>(text[i]) % prime;
+      result = (r >= prime) ? (r - prime) : r;
+    }
+    return result;
+  }
+
+  // writes the state after the construction processed all text positions
+  // before next_idx, and the bps has the given length (fingerprint is the
+  // fingerprint of the text)
+  void save(const uint64_t n,
+            const uint64_t fingerprint,
+            const uint64_t next_idx,
+            const bit_vector& bps,
+            const uint64_t length) {
+    const uint64_t complete_words = div64(length);
+    if (complete_words > words_written_) {
+      write_at(header_words + words_written_, bps.data() + words_written_,
+               complete_words - words_written_);
+      std::fflush(file_);
+    }
+    words_written_ = complete_words;
+
+    const uint64_t partial_word =
+        (mod64(length) > 0)
+            ? (bps.data()[complete_words] & ~(word_all_one >> mod64(length)))
+            : 0;
+    const uint64_t header[header_words] = {magic,    n,      fingerprint,
+                                           next_idx, length, partial_word};
+    write_at(0, header, header_words);
+    std::fflush(file_);
+  }
+
+  // reads the bps prefix of the last checkpoint into bps (which must be all
+  // zero); returns false if there is no valid checkpoint for a text of length n
+  // with the given fingerprint
+  bool load(const uint64_t n,
+            const uint64_t fingerprint,
+            bit_vector& bps,
+            state& result) {
+    uint64_t header[header_words];
+    if (!read_at(0, header, header_words) || header[0] != magic ||
+        header[1] != n || header[2] != fingerprint || header[4] > bps.size())
+      return false;
+
+    const uint64_t complete_words = div64(header[4]);
+    if (!read_at(header_words, bps.data(), complete_words))
+      return false;
+    bps.data()[complete_words] = header[5];
+    words_written_ = complete_words;
+    result = {header[1], header[3], header[4]};
+    return true;
+  }
+
+  xss_checkpoint_file(const xss_checkpoint_file&) = delete;
+  xss_checkpoint_file& operator=(const xss_checkpoint_file&) = delete;
+};
@@ -21,69 +21,212 @@
 #pragma once
 
 #include <bitset>
+#include <data_structures/bit_vectors/bps_stream.hpp>
 #include <data_structures/stacks/lcp_stack/lcp_stack.hpp>
 #include <data_structures/stacks/stack_strategy.hpp>
+#include <data_structures/stacks/telescope_stack/telescope_stack.hpp>
 #include <sstream>
 #include <util/common.hpp>
 
 #include <algorithms/xss_isa_psv.hpp>
+#include <algorithms/xss_real_stats.hpp>
 #include <data_structures/bit_vectors/support/bps_support_sdsl.hpp>
 
+// output policies: besides the bps, the context can write the pss of each
+// pushed index into an array
+struct xss_no_array_output {
+  xssr_always_inline void set(const uint64_t, const uint64_t) {}
+  xssr_always_inline void extend_run(const uint64_t,
+                                     const uint64_t,
+                                     const uint64_t) {}
+};
+
+template <typename index_type>
+struct xss_pss_array_output {
+  index_type* data_;
+
+  xssr_always_inline void set(const uint64_t idx, const uint64_t pss) {
+    data_[idx] = pss;
+  }
+
+  // the run extension repeats the period (i - period, i] right after i; pss
+  // values inside of the period move along, all others stay the same
+  xssr_always_inline void extend_run(const uint64_t i,
+                                     const uint64_t period,
+                                     const uint64_t repetitions) {
+    const uint64_t period_start = i - period;
+    index_type* const end = data_ + i + repetitions * period + 1;
+    for (index_type* dst = data_ + i + 1; dst < end; dst += period) {
+      const index_type* src = dst - period;
+      const uint64_t length = std::min(period, (uint64_t)(end - dst));
+      for (uint64_t k = 0; k < length; ++k) {
+        const uint64_t pss = src[k];
+        dst[k] = (pss >= period_start) ? (pss + period) : pss;
+      }
+    }
+  }
+};
+
 template <stack_strategy strategy,
           typename ctz_type,
           bool use_delta_type,
           typename bv_type,
-          typename value_type>
+          typename value_type,
+          typename output_type = xss_no_array_output,
+          typename stats_type = xss_no_stats,
+          typename index_type = uint64_t>
 class xss_real_ctx {
 private:
-  using lcp_stack_type =
-      typename lcp_stack<strategy, ctz_type, use_delta_type, value_type>::type;
+  using lcp_stack_type = typename lcp_stack<strategy,
+                                            ctz_type,
+                                            use_delta_type,
+                                            value_type,
+                                            index_type>::type;
+  using reverse_stack_type = telescope_stack<strategy, ctz_type, index_type>;
 
   constexpr static uint64_t lmask = 1ULL << 63;
+  constexpr static bool streaming = is_bps_stream<bv_type>::value;
+  constexpr static bool array_output =
+      !std::is_same<output_type, xss_no_array_output>::value;
 
-  const value_type* text_;
-  const uint64_t n_;
-  const uint64_t data_size_;
+  text_pointer_t<value_type> text_;
+  uint64_t n_;
+  uint64_t data_size_;
   uint64_t* data_;
   bv_type& bv_;
 
   lcp_stack_type lcp_stack_;
+  // scratch stack of the lookahead, which reverses the order of the skipped
+  // indices; it only contains the sentinel between two lookaheads (and the
+  // lookahead skips at most n / 4 indices)
+  reverse_stack_type reverse_stack_;
+  output_type output_;
 
   uint64_t current_word_size_;
   uint64_t current_word_data_index_;
+  // number of words that already left the window (only for bps_stream)
+  uint64_t word_offset_;
 
   xssr_always_inline void automatic_new_word() {
     if (xssr_unlikely(current_word_size_ == 64)) {
       ++current_word_data_index_;
       current_word_size_ = 0;
+      flush_if_necessary();
     }
   }
 
+  // keep the current and the next word inside of the window
+  xssr_always_inline void flush_if_necessary() {
+    if constexpr (streaming) {
+      if (xssr_unlikely(current_word_data_index_ + 2 >= data_size_)) {
+        const uint64_t flushed = bv_.flush();
+        current_word_data_index_ -= flushed;
+        word_offset_ += flushed;
+      }
+    }
+  }
+
+  xssr_always_inline void set_current_length(const uint64_t length) {
+    current_word_data_index_ = div64(length) - word_offset_;
+    current_word_size_ = mod64(length);
+    flush_if_necessary();
+  }
+
 public:
-  xss_real_ctx(const value_type* text, bv_type& bv, const uint64_t delta)
+  xss_real_ctx(text_pointer_t<value_type> text,
+               bv_type& bv,
+               const uint64_t delta)
+      : xss_real_ctx(text, bv, delta, bv.size() / 2 - 1) {}
+
+  // the bps may cover only a part of the text (e.g. a block of a parallel
+  // construction), but the lcp stack needs the length of the whole text
+  xss_real_ctx(text_pointer_t<value_type> text,
+               bv_type& bv,
+               const uint64_t delta,
+               const uint64_t n,
+               const output_type output = output_type())
       : text_(text),
-        n_(bv.size() / 2 - 1),
+        n_(n),
         data_size_(bv.data_size()),
         data_(bv.data()),
         bv_(bv),
         lcp_stack_(n_, delta, text),
+        reverse_stack_(div<4>(n_) + 1),
+        output_(output),
         current_word_size_(0),
-        current_word_data_index_(0) {}
+        current_word_data_index_(0),
+        word_offset_(0) {}
+
+  // prepares the context for another text of at most the initial length
+  // (the stack must only contain the sentinel, and the bps must be all zero)
+  void reset(text_pointer_t<value_type> text, const uint64_t n) {
+    text_ = text;
+    n_ = n;
+    lcp_stack_.reset(text, n);
+    current_word_size_ = 0;
+    current_word_data_index_ = 0;
+    word_offset_ = 0;
+  }
+
+  // continues on a longer text that starts with the same characters as the
+  // current text (at least up to the current position), after the bps was
+  // resized accordingly; the stack is kept, and the bits behind the current
+  // length are cleared (only for bit_vector, and the stacks must be able to
+  // hold the indices of the longer text, e.g. the naive stacks)
+  void extend(text_pointer_t<value_type> text, const uint64_t n) {
+    text_ = text;
+    n_ = n;
+    lcp_stack_.reset(text, n);
+    data_ = bv_.data();
+    data_size_ = bv_.data_size();
+    const uint64_t length = current_length();
+    const uint64_t word_idx = div64(length);
+    data_[word_idx] &= ~(word_all_one >> mod64(length));
+    memset(data_ + word_idx + 1, 0, mul8(data_size_ - word_idx - 1));
+  }
 
   xssr_always_inline void push_with_lcp(const uint64_t idx,
                                         const uint64_t lcp) {
+    if constexpr (array_output)
+      output_.set(idx, lcp_stack_.top_idx());
+    if constexpr (stats_type::enabled)
+      stats_type::local().push();
     lcp_stack_.push_with_lcp(idx, lcp);
   }
 
+  // pushes the indices idx, idx + period, ... (count many) with the lcps
+  // lcp, lcp - period, ...
+  xssr_always_inline void push_run(const uint64_t idx,
+                                   const uint64_t period,
+                                   const uint64_t lcp,
+                                   const uint64_t count) {
+    if constexpr (array_output) {
+      output_.set(idx, lcp_stack_.top_idx());
+      for (uint64_t k = 1; k < count; ++k)
+        output_.set(idx + k * period, idx + (k - 1) * period);
+    }
+    if constexpr (stats_type::enabled)
+      stats_type::local().push(count);
+    lcp_stack_.push_run(idx, period, lcp, count);
+  }
+
   xssr_always_inline void push_without_lcp(const uint64_t idx) {
+    if constexpr (array_output)
+      output_.set(idx, lcp_stack_.top_idx());
+    if constexpr (stats_type::enabled)
+      stats_type::local().push();
     lcp_stack_.push_without_lcp(idx);
   }
 
   xssr_always_inline void pop_with_lcp() {
+    if constexpr (stats_type::enabled)
+      stats_type::local().pop();
     lcp_stack_.pop_with_lcp();
   }
 
   xssr_always_inline void pop_without_lcp() {
+    if constexpr (stats_type::enabled)
+      stats_type::local().pop();
     lcp_stack_.pop_without_lcp();
   }
 
@@ -91,6 +234,10 @@ public:
     return lcp_stack_.top_idx();
   }
 
+  xssr_always_inline reverse_stack_type& reverse_stack() {
+    return reverse_stack_;
+  }
+
   xssr_always_inline uint64_t top_lcp() const {
     return lcp_stack_.top_lcp();
   }
@@ -117,22 +264,25 @@ public:
   xssr_always_inline void soft_set_word(const uint64_t idx,
                                         const uint64_t word) const {
     const uint64_t bit_idx = mod64(idx);
+    const uint64_t word_idx = div64(idx) - word_offset_;
     if (xssr_likely(bit_idx > 0)) {
-      data_[div64(idx)] |= word >> bit_idx;
-      data_[div64(idx) + 1] |= word << (64 - bit_idx);
+      data_[word_idx] |= word >> bit_idx;
+      data_[word_idx + 1] |= word << (64 - bit_idx);
     } else
-      data_[div64(idx)] = word;
+      data_[word_idx] = word;
   }
 
   xssr_always_inline void append_copy_unsafe(const uint64_t source,
                                              const uint64_t length) {
     uint64_t dest = current_length();
     for (uint64_t i = 0; i < length; i += 64) {
+      if constexpr (streaming) {
+        set_current_length(dest + i);
+      }
       soft_set_word(dest + i, bv_.get_word(source + i));
     }
     const uint64_t cur_len = dest + length;
-    current_word_data_index_ = div64(cur_len);
-    current_word_size_ = mod64(cur_len);
+    set_current_length(cur_len);
     bv_.set_word(cur_len, word_all_zero);
   }
 
@@ -149,8 +299,7 @@ public:
         start_word |= start_word >> distance;
       }
       soft_set_word(dest, start_word);
-      current_word_data_index_ = div64(dest + tiny_length);
-      current_word_size_ = mod64(dest + tiny_length);
+      set_current_length(dest + tiny_length);
       append_copy_unsafe(source, length - tiny_length);
     } else {
       append_copy_unsafe(source, length);
@@ -163,6 +312,8 @@ public:
     const uint64_t copy_length_total = repetitions * copy_length_per_repetition;
     const uint64_t copy_from = current_length() - copy_length_per_repetition;
     append_copy(copy_from, copy_length_total);
+    if constexpr (array_output)
+      output_.extend_run(top_idx(), period, repetitions);
   }
 
   xssr_always_inline void extend_decreasing_run(const uint64_t period,
@@ -171,13 +322,31 @@ public:
     const uint64_t copy_length_total = repetitions * copy_length_per_repetition;
     const uint64_t copy_from = current_length() - copy_length_per_repetition;
     append_copy(copy_from, copy_length_total);
+    if constexpr (array_output)
+      output_.extend_run(top_idx(), period, repetitions);
   }
 
   xssr_always_inline bool operator[](uint64_t index) const {
-    return (data_[div64(index)] & (lmask >> mod64(index)));
+    if constexpr (streaming) {
+      if (xssr_unlikely(div64(index) < word_offset_))
+        return bv_[index];
+    }
+    return (data_[div64(index) - word_offset_] & (lmask >> mod64(index)));
+  }
+
+  // continues writing after the first length bits (e.g. after these bits
+  // were loaded from a checkpoint)
+  xssr_always_inline void resume_at(const uint64_t length) {
+    set_current_length(length);
+  }
+
+  // hands the remaining words to the sink (only for bps_stream)
+  xssr_always_inline void finish() {
+    if constexpr (streaming)
+      bv_.finish();
   }
 
   xssr_always_inline uint64_t current_length() const {
-    return mul64(current_word_data_index_) + current_word_size_;
+    return mul64(word_offset_ + current_word_data_index_) + current_word_size_;
   }
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_real.hpp>
+#include <cstring>
+#include <data_structures/bit_vectors/bps_stream.hpp>
+#include <data_structures/lce/lce_herlez.hpp>
+
+// builds the pss tree of a text whose buffer may be overwritten: the in-place
+// lce of lce_herlez replaces the text by its fingerprints (all characters are
+// decoded from them), and the bps of the tree is moved into the text buffer
+// afterwards. while the fingerprints are in use, the bps is streamed through a
+// temporary file (see bps_stream.hpp), such that besides the text buffer only
+// the stack and a window of window_words words of the bps are kept in memory;
+// once the construction is done, the text buffer is the only memory that is
+// left (the bps encodes the lyndon array with 2 bits per character, see
+// xss_real::run_lyndon_array)
+//
+// the buffer must provide buffer_bytes(n) bytes, i.e. the n characters
+// rounded up to a multiple of 8 bytes
+template <stack_strategy strategy = DYNAMIC_BUFFERED,
+          typename ctz_type = ctz_builtin>
+class xss_real_inplace {
+private:
+  using algorithm_type = xss_real<strategy, ctz_type, lce_herlez>;
+
+public:
+  constexpr static uint64_t default_window_words = 1ULL << 16;
+
+  template <typename value_type>
+  constexpr static uint64_t buffer_bytes(const uint64_t n) {
+    return mul8(div8(n * sizeof(value_type) + 7));
+  }
+
+  // overwrites the buffer with the 64 bit words of the bps (in the layout of
+  // bit_vector::data()) and returns the length 2n + 2 of the bps
+  template <typename value_type>
+  static uint64_t run(value_type* text,
+                      const uint64_t n,
+                      const uint64_t delta = 4,
+                      const uint64_t window_words = default_window_words) {
+    const uint64_t length = 2 * n + 2;
+    bps_file_sink sink;
+    {
+      LcePrezza prezza(reinterpret_cast<uint8_t*>(text),
+                       n * sizeof(value_type));
+      const herlez_text_pointer<value_type> fingerprints(&prezza);
+      bps_stream<bps_file_sink> bps(length, sink, window_words);
+      if (delta > 0)
+        algorithm_type::template build<true>(fingerprints, n, delta, bps);
+      else
+        algorithm_type::template build<false>(fingerprints, n, delta, bps);
+    }
+    sink.read(reinterpret_cast<uint64_t*>(text), 0, div64(length + 63));
+    return length;
+  }
+
+  // copies the bps out of a buffer that has been overwritten by run
+  static bit_vector get_bps(const void* buffer, const uint64_t n) {
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    memcpy(result.data(), buffer, mul8(div64(result.size() + 63)));
+    return result;
+  }
+};
@@ -0,0 +1,85 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_real.hpp>
+#include <data_structures/bit_vectors/bit_vector.hpp>
+#include <data_structures/lce/lce_naive.hpp>
+#include <vector>
+
+// Computes the bps of the nss tree (the parent of node i is nss[i]). The nodes
+// are visited in decreasing order, and there is an artificial root n (the nss
+// of node n - 1). Thus, the k-th opening parenthesis belongs to node n - k, and
+// decode_nss restores the nss array (and the lyndon array nss[i] - i) with a
+// single sequential pass.
+// The nss array is computed by xss_real (with run extension and lookahead, so
+// it takes linear time), and bps_from_nss turns it into the bps: before node i
+// opens, the nodes on the path from i + 1 up to nss[i] (excluding nss[i]) are
+// closed, which are exactly the children of i in the pss tree.
+template <stack_strategy strategy = DYNAMIC_BUFFERED,
+          typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_naive>
+class xss_real_nss {
+public:
+  template <typename value_type>
+  static auto
+  run(const value_type* text, const uint64_t n, const uint64_t delta = 4) {
+    return bps_from_nss(
+        xss_real<strategy, ctz_type, lce_type>::run_nss_array(text, n, delta));
+  }
+
+  // (every node is closed once, and the path from i + 1 up to nss[i] follows
+  // the nss array, so no stack is needed)
+  template <typename array_type>
+  static bit_vector bps_from_nss(const array_type& nss) {
+    const uint64_t n = nss.size();
+    bit_vector result(2 * n + 2, BV_FILL_ZERO);
+    // artificial root and node n - 1
+    result.set_one(0);
+    result.set_one(1);
+    uint64_t k = 2;
+    // n-2 to 0
+    for (uint64_t i = n - 1; i-- > 0;) {
+      for (uint64_t j = i + 1; j != nss[i]; j = nss[j]) {
+        ++k;
+      }
+      result.set_one(k++);
+    }
+    // (the remaining bits close node 0, node n - 1 and the root)
+    return result;
+  }
+
+  static std::vector<uint64_t> decode_nss(const bit_vector& bps) {
+    const uint64_t n = bps.size() / 2 - 1;
+    std::vector<uint64_t> result(n);
+    std::vector<uint64_t> open_nodes = {n};
+    uint64_t node = n;
+    for (uint64_t k = 1; k < bps.size() - 1; ++k) {
+      if (bps[k]) {
+        result[--node] = open_nodes.back();
+        open_nodes.push_back(node);
+      } else {
+        open_nodes.pop_back();
+      }
+    }
+    return result;
+  }
+};
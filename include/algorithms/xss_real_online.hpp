@@ -0,0 +1,153 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_real.hpp>
+#include <vector>
+
+// lce functor that remembers the smallest position i of a query lce(j, i)
+// (with j < i) that reaches the last position of the text, i.e. the sentinel
+// (the result of such a query may change when characters are appended)
+template <typename lce_fn_type>
+struct xss_end_watch_lce {
+  lce_fn_type lce_;
+  const uint64_t last_;
+  uint64_t first_touch_;
+
+  xss_end_watch_lce(lce_fn_type lce, const uint64_t n)
+      : lce_(lce), last_(n - 1), first_touch_(last_) {}
+
+  xssr_always_inline uint64_t operator()(const uint64_t j,
+                                         const uint64_t i,
+                                         const uint64_t lcp = 0) {
+    const uint64_t result = lce_(j, i, lcp);
+    if (xssr_unlikely(i + result >= last_))
+      first_touch_ = std::min(first_touch_, i);
+    return result;
+  }
+};
+
+// pss tree of a text that grows at the end; the text is kept with both
+// sentinels, and the characters are appended in front of the last sentinel
+//
+// the scan reads text behind the current position only through lce queries
+// (and the characters right behind their results). thus, appending characters
+// only changes how position i is processed if one of its lce queries reached
+// the sentinel, which requires that the suffix of the text that starts at i
+// also occurs at an earlier position. all positions in front of the first such
+// position are final, and the stack of the naive strategy is kept at this
+// frontier. an append rewrites the bps behind the old frontier on a copy of
+// the stack, which finds the new frontier, and then moves the stack from the
+// old frontier to the new one. thus, if the queries of the last positions are
+// short (which is the common case), the time is proportional to the number of
+// appended characters (plus the amortized time of growing the bps). besides
+// the text and the bps, only the stack is kept in memory
+template <typename value_type,
+          typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_naive>
+class xss_real_online {
+private:
+  using algorithm_type = xss_real<NAIVE, ctz_type, lce_type>;
+  using ctx_type = xss_real_ctx<NAIVE,
+                                ctz_type,
+                                false,
+                                bit_vector,
+                                value_type,
+                                xss_no_array_output,
+                                xss_no_stats,
+                                uint64_t>;
+
+  std::vector<value_type> text_;
+  bit_vector bps_;
+  // stack and bps after processing the positions [1, frontier_)
+  ctx_type ctx_;
+  uint64_t frontier_;
+
+public:
+  // text[0] and text[n - 1] are the sentinels
+  xss_real_online(const value_type* text, const uint64_t n)
+      : text_({text[0], text[n - 1]}),
+        bps_(6, BV_FILL_ZERO),
+        ctx_(text_.data(), bps_, 0, 2),
+        frontier_(1) {
+    ctx_.open();
+    ctx_.open();
+    append(text + 1, n - 2);
+  }
+
+  xss_real_online(const xss_real_online&) = delete;
+  xss_real_online& operator=(const xss_real_online&) = delete;
+
+  // (the characters must be larger than the sentinel)
+  void append(const value_type* chars, const uint64_t count) {
+    const value_type sentinel = text_.back();
+    text_.pop_back();
+    text_.insert(text_.end(), chars, chars + count);
+    text_.push_back(sentinel);
+
+    const uint64_t n = text_.size();
+    bps_.resize(2 * n + 2);
+    ctx_.extend(text_.data(), n);
+    auto get_lcp = lce_type<value_type>::get_lce(text_.data(), n);
+    xss_end_watch_lce<decltype(get_lcp)> watch(get_lcp, n);
+
+    const uint64_t first_word = div64(ctx_.current_length());
+    ctx_type tail(ctx_);
+    algorithm_type::scan(text_.data(), tail, watch, frontier_, n - 1);
+    algorithm_type::template finish_bps<false>(tail);
+    if (watch.first_touch_ == frontier_)
+      return;
+
+    // the positions [frontier_, watch.first_touch_) are processed exactly
+    // like in the scan of tail, but the scan may clear bits behind the end of
+    // its bps, so the bps of tail is restored afterwards
+    const std::vector<uint64_t> tail_words(bps_.data() + first_word,
+                                           bps_.data() + bps_.data_size());
+    algorithm_type::scan(text_.data(), ctx_, get_lcp, frontier_,
+                         watch.first_touch_);
+    std::copy(tail_words.begin(), tail_words.end(), bps_.data() + first_word);
+    frontier_ = watch.first_touch_;
+  }
+
+  void append(const value_type c) {
+    append(&c, 1);
+  }
+
+  // the bps of the pss tree of the current text (as computed by xss_real)
+  const bit_vector& bps() const {
+    return bps_;
+  }
+
+  const value_type* text() const {
+    return text_.data();
+  }
+
+  // length of the current text (including both sentinels)
+  uint64_t size() const {
+    return text_.size();
+  }
+
+  // the positions [1, frontier()) are final, the next append rewrites only
+  // the bps of the later positions
+  uint64_t frontier() const {
+    return frontier_;
+  }
+};
@@ -0,0 +1,185 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_real.hpp>
+#include <data_structures/ctz/ctz.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A configuration of xss_real, e.g. the winner of the autotuner of the
+// benchmark (--autotune). Profiles are stored as text files with one
+// key=value pair per line:
+//   strategy=DYNAMIC_BUFFERED
+//   ctz=CTZ_BUILTIN
+//   delta=4
+//   active_threshold=128
+struct xss_real_profile {
+  stack_strategy strategy = DYNAMIC_BUFFERED;
+  ctz_strategy ctz = CTZ_BUILTIN;
+  uint64_t delta = 4;
+  uint64_t active_threshold = 128;
+
+  // the values that can be chosen at runtime (each combination of strategy,
+  // ctz and active_threshold is a separate instantiation of xss_real)
+  constexpr static stack_strategy strategies[] = {NAIVE, STATIC, DYNAMIC,
+                                                  DYNAMIC_BUFFERED};
+  constexpr static ctz_strategy ctzs[] = {CTZ_BUILTIN, CTZ_DEBRUIJN};
+  constexpr static uint64_t active_thresholds[] = {128, 1024};
+  constexpr static uint64_t deltas[] = {0, 4, 16};
+
+  static std::string ctz_to_string(const ctz_strategy ctz) {
+    return (ctz == CTZ_DEBRUIJN) ? ctz_debruijn::to_string()
+                                 : ctz_builtin::to_string();
+  }
+
+  std::string to_string() const {
+    return "strategy=" + std::to_string(strategy) +
+           " ctz=" + ctz_to_string(ctz) + " delta=" + std::to_string(delta) +
+           " active_threshold=" + std::to_string(active_threshold);
+  }
+
+  // all profiles that the autotuner compares
+  static std::vector<xss_real_profile> candidates() {
+    std::vector<xss_real_profile> result;
+    for (const auto strategy : strategies) {
+      for (const auto ctz : ctzs) {
+        for (const auto threshold : active_thresholds) {
+          // (the naive stack does not use delta)
+          for (const auto delta : deltas) {
+            result.push_back({strategy, ctz, delta, threshold});
+            if (strategy == NAIVE)
+              break;
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  void save(const std::string& path) const {
+    std::ofstream stream(path);
+    stream << "strategy=" << std::to_string(strategy) << "\n"
+           << "ctz=" << ctz_to_string(ctz) << "\n"
+           << "delta=" << delta << "\n"
+           << "active_threshold=" << active_threshold << "\n";
+    if (!stream)
+      throw std::runtime_error("Could not write profile " + path + ".");
+  }
+
+  // keys that are missing keep their default value
+  static xss_real_profile load(const std::string& path) {
+    std::ifstream stream(path);
+    if (!stream)
+      throw std::runtime_error("Could not open profile " + path + ".");
+    xss_real_profile result;
+    std::string line;
+    while (std::getline(stream, line)) {
+      const uint64_t eq = line.find('=');
+      if (line.empty() || line[0] == '#' || eq == std::string::npos)
+        continue;
+      const std::string key = line.substr(0, eq);
+      const std::string value = line.substr(eq + 1);
+      if (key == "strategy")
+        result.strategy = parse_strategy(value);
+      else if (key == "ctz")
+        result.ctz = parse_ctz(value);
+      else if (key == "delta")
+        result.delta = std::stoull(value);
+      else if (key == "active_threshold")
+        result.active_threshold = parse_threshold(std::stoull(value));
+      else
+        throw std::runtime_error("Unknown key " + key + " in profile.");
+    }
+    return result;
+  }
+
+private:
+  static stack_strategy parse_strategy(const std::string& value) {
+    for (const auto strategy : strategies) {
+      if (value == std::to_string(strategy))
+        return strategy;
+    }
+    throw std::runtime_error("Unknown stack strategy " + value + ".");
+  }
+
+  static ctz_strategy parse_ctz(const std::string& value) {
+    for (const auto ctz : ctzs) {
+      if (value == ctz_to_string(ctz))
+        return ctz;
+    }
+    throw std::runtime_error("Unknown ctz type " + value + ".");
+  }
+
+  static uint64_t parse_threshold(const uint64_t value) {
+    for (const auto threshold : active_thresholds) {
+      if (value == threshold)
+        return threshold;
+    }
+    throw std::runtime_error("Unsupported active threshold " +
+                             std::to_string(value) + ".");
+  }
+};
+
+// runs the instantiation of xss_real that matches the profile
+template <template <typename> class lce_type = lce_naive>
+class xss_real_tuned {
+public:
+  template <typename value_type>
+  static bit_vector run(const value_type* text,
+                        const uint64_t n,
+                        const xss_real_profile& profile) {
+    switch (profile.strategy) {
+    case NAIVE:
+      return run_ctz<NAIVE>(text, n, profile);
+    case STATIC:
+      return run_ctz<STATIC>(text, n, profile);
+    case DYNAMIC:
+      return run_ctz<DYNAMIC>(text, n, profile);
+    default:
+      return run_ctz<DYNAMIC_BUFFERED>(text, n, profile);
+    }
+  }
+
+private:
+  template <stack_strategy strategy, typename value_type>
+  static bit_vector run_ctz(const value_type* text,
+                            const uint64_t n,
+                            const xss_real_profile& profile) {
+    if (profile.ctz == CTZ_DEBRUIJN)
+      return run_threshold<strategy, ctz_debruijn>(text, n, profile);
+    return run_threshold<strategy, ctz_builtin>(text, n, profile);
+  }
+
+  template <stack_strategy strategy, typename ctz_type, typename value_type>
+  static bit_vector run_threshold(const value_type* text,
+                                  const uint64_t n,
+                                  const xss_real_profile& profile) {
+    if (profile.active_threshold == 1024) {
+      return xss_real<strategy, ctz_type, lce_type, xss_no_stats, 1024>::run(
+          text, n, profile.delta);
+    }
+    return xss_real<strategy, ctz_type, lce_type, xss_no_stats, 128>::run(
+        text, n, profile.delta);
+  }
+};
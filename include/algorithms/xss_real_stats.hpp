@@ -0,0 +1,121 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <sstream>
+#include <util/common.hpp>
+
+// statistics policies of xss_real; with xss_no_stats, none of the counters
+// is touched (all hooks are guarded by stats_type::enabled)
+struct xss_no_stats {
+  constexpr static bool enabled = false;
+};
+
+// the counters are thread local, such that parallel runs do not interfere
+// (a parallel run merges the counters of all threads into the calling thread)
+struct xss_stats {
+  constexpr static bool enabled = true;
+
+  uint64_t pushes = 0;
+  uint64_t pops = 0;
+  uint64_t stack_depth = 0;
+  uint64_t max_stack_depth = 0;
+  uint64_t lce_calls = 0;
+  uint64_t lce_characters = 0;
+  uint64_t lookaheads = 0;
+  uint64_t skipped_al = 0;
+  uint64_t run_extensions = 0;
+  uint64_t skipped_re = 0;
+  // run extensions by floor(log2(period))
+  uint64_t run_extensions_by_period[64] = {};
+
+  static xss_stats& local() {
+    thread_local xss_stats stats;
+    return stats;
+  }
+
+  void reset() {
+    *this = xss_stats();
+  }
+
+  void merge(const xss_stats& other) {
+    pushes += other.pushes;
+    pops += other.pops;
+    max_stack_depth = std::max(max_stack_depth, other.max_stack_depth);
+    lce_calls += other.lce_calls;
+    lce_characters += other.lce_characters;
+    lookaheads += other.lookaheads;
+    skipped_al += other.skipped_al;
+    run_extensions += other.run_extensions;
+    skipped_re += other.skipped_re;
+    for (uint64_t k = 0; k < 64; ++k)
+      run_extensions_by_period[k] += other.run_extensions_by_period[k];
+  }
+
+  xssr_always_inline void push(const uint64_t count = 1) {
+    pushes += count;
+    stack_depth += count;
+    max_stack_depth = std::max(max_stack_depth, stack_depth);
+  }
+
+  xssr_always_inline void pop() {
+    ++pops;
+    --stack_depth;
+  }
+
+  // (for lce_naive, characters is the number of compared characters)
+  xssr_always_inline void lce(const uint64_t characters) {
+    ++lce_calls;
+    lce_characters += characters;
+  }
+
+  xssr_always_inline void lookahead(const uint64_t skipped) {
+    ++lookaheads;
+    skipped_al += skipped;
+  }
+
+  xssr_always_inline void run_extension(const uint64_t period,
+                                        const uint64_t skipped) {
+    ++run_extensions;
+    ++run_extensions_by_period[63 - __builtin_clzll(period)];
+    skipped_re += skipped;
+  }
+
+  // key=value pairs for the RESULT lines of the benchmark
+  std::string to_string() const {
+    std::stringstream result;
+    result << "pushes=" << pushes << " pops=" << pops
+           << " max_stack_depth=" << max_stack_depth
+           << " lce_calls=" << lce_calls
+           << " lce_characters=" << lce_characters
+           << " lookaheads=" << lookaheads << " skipped_by_al=" << skipped_al
+           << " run_extensions=" << run_extensions
+           << " skipped_by_re=" << skipped_re
+           << " run_extensions_by_log_period=";
+    if (run_extensions == 0)
+      result << "()";
+    for (uint64_t k = 0; k < 64; ++k) {
+      if (run_extensions_by_period[k] > 0)
+        result << "(" << k << "," << run_extensions_by_period[k] << ")";
+    }
+    return result.str();
+  }
+};
@@ -0,0 +1,169 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <algorithms/xss_real.hpp>
+#include <data_structures/lce/lce_hybrid.hpp>
+#include <omp.h>
+#include <vector>
+
+// the maximal repetition text[start, start + length) with smallest period
+// period (length >= 2 * period)
+struct xss_run {
+  uint64_t start;
+  uint64_t length;
+  uint64_t period;
+
+  bool operator==(const xss_run& other) const {
+    return start == other.start && length == other.length &&
+           period == other.period;
+  }
+
+  bool operator!=(const xss_run& other) const {
+    return !operator==(other);
+  }
+};
+
+// computes all runs of text[1, n - 1). by the runs theorem, each run has an
+// order of the characters (the usual one, or its inverse) under which every
+// lyndon root of the run that does not start at the start of the run is the
+// longest lyndon word starting there, i.e. the lyndon root [i, j) ends at the
+// nss j of i under this order. this is the order under which the character
+// behind the run is smaller than the character one period before it (for a
+// run that ends right before the sentinel, both orders qualify).
+//
+// hence, every position i with nss j (under either order) is a candidate for
+// a run with period j - i, which is extended to the left (by at most
+// period + 1 characters) and to the right. a run is reported only by its
+// order, and only by its lyndon root that starts in (start, start + period],
+// such that each run is found exactly once. the nss arrays of the two orders
+// are computed in parallel. there are at most 2n candidates with two lce
+// queries each, hence the time is linear given constant time lce queries
+// (lce_type answers them on the text, and on the reversed text for the
+// extensions to the left)
+template <stack_strategy strategy = DYNAMIC_BUFFERED,
+          typename ctz_type = ctz_builtin,
+          template <typename> class lce_type = lce_hybrid>
+class xss_runs {
+private:
+  using algorithm_type = xss_real<strategy, ctz_type>;
+
+  constexpr static uint64_t naive_length = 64;
+
+public:
+  // the runs are sorted by their start
+  template <typename value_type>
+  static std::vector<xss_run>
+  run(const value_type* text, const uint64_t n, const uint64_t delta = 4) {
+    if (n < (1ULL << 32))
+      return run_internal<uint32_t>(text, n, delta);
+    else
+      return run_internal<uint64_t>(text, n, delta);
+  }
+
+private:
+  template <typename index_type, typename value_type>
+  static std::vector<xss_run>
+  run_internal(const value_type* text, const uint64_t n, const uint64_t delta) {
+    if (n < 4)
+      return {};
+
+    // the inverse order of the characters (the sentinels stay the smallest),
+    // and the reversed text for the extensions to the left
+    const value_type max_char = *std::max_element(text + 1, text + n - 1);
+    std::vector<value_type> inverse(n);
+    std::vector<value_type> reversed(n);
+    for (uint64_t i = 1; i < n - 1; ++i) {
+      inverse[i] = max_char - text[i] + 1;
+      reversed[n - 1 - i] = text[i];
+    }
+    inverse[0] = inverse[n - 1] = reversed[0] = reversed[n - 1] = 0;
+
+    // (the lce structures are shared by both orders)
+    auto lce = lce_type<value_type>::get_lce(text, n);
+    auto lce_reversed = lce_type<value_type>::get_lce(reversed.data(), n);
+
+    std::vector<xss_run> runs[2];
+#pragma omp parallel for num_threads(2) schedule(static, 1)
+    for (uint64_t order = 0; order < 2; ++order) {
+      const value_type* order_text = (order == 0) ? text : inverse.data();
+      const auto nss = algorithm_type::template run_nss_array<index_type>(
+          order_text, n, delta);
+      for (uint64_t i = 1; i < n - 1; ++i) {
+        const uint64_t j = nss[i];
+        const uint64_t period = j - i;
+        // (text[i - 1] and text[j - 1] are the first characters to the left)
+        const uint64_t left = capped_lce(lce_reversed, reversed.data(), n - i,
+                                         n - j, period + 1);
+        if (left == 0 || left > period)
+          continue;
+        const uint64_t right = lce(i, j);
+        if (left + right < period)
+          continue;
+        // (a run that ends at the sentinel belongs to both orders, and is
+        // reported by the usual one)
+        const uint64_t end = j + right;
+        if (order_text[end] < order_text[end - period] &&
+            (order == 0 || end < n - 1))
+          runs[order].push_back({i - left, period + left + right, period});
+      }
+    }
+    return sort_by_start(runs[0], runs[1], n);
+  }
+
+  // min(lce(i, j), limit); the lce is only queried once a naive scan has
+  // matched naive_length characters (most candidates are ruled out by a few
+  // characters to their left, even if their extension to the left is long)
+  template <typename lce_instance_type, typename value_type>
+  xssr_always_inline static uint64_t capped_lce(lce_instance_type& lce,
+                                                const value_type* text,
+                                                const uint64_t i,
+                                                const uint64_t j,
+                                                const uint64_t limit) {
+    const uint64_t naive_limit = std::min(limit, naive_length);
+    uint64_t lcp = 0;
+    while (lcp < naive_limit && text[i + lcp] == text[j + lcp])
+      ++lcp;
+    if (lcp < naive_length)
+      return lcp;
+    return std::min(lce(i, j, lcp), limit);
+  }
+
+  // (counting sort)
+  static std::vector<xss_run> sort_by_start(const std::vector<xss_run>& a,
+                                            const std::vector<xss_run>& b,
+                                            const uint64_t n) {
+    std::vector<uint64_t> bucket(n + 1, 0);
+    for (const auto& r : a)
+      ++bucket[r.start + 1];
+    for (const auto& r : b)
+      ++bucket[r.start + 1];
+    for (uint64_t i = 1; i <= n; ++i)
+      bucket[i] += bucket[i - 1];
+    std::vector<xss_run> result(a.size() + b.size());
+    for (const auto& r : a)
+      result[bucket[r.start]++] = r;
+    for (const auto& r : b)
+      result[bucket[r.start]++] = r;
+    return result;
+  }
+};
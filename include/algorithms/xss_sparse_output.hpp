@@ -0,0 +1,185 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <data_structures/index_array.hpp>
+#include <stack>
+#include <type_traits>
+#include <util/common.hpp>
+#include <vector>
+
+// positions whose pss and nss are reported: every k-th position (0, k, 2k,
+// ...), or a sorted set of positions
+class xss_sample {
+private:
+  const uint64_t n_;
+  const uint64_t k_;
+  const std::vector<uint64_t>* positions_;
+
+public:
+  xss_sample(const uint64_t n, const uint64_t k)
+      : n_(n), k_(std::max(k, (uint64_t) 1)), positions_(nullptr) {}
+
+  xss_sample(const uint64_t n, const std::vector<uint64_t>& positions)
+      : n_(n), k_(1), positions_(&positions) {}
+
+  xssr_always_inline uint64_t size() const {
+    return (positions_ != nullptr) ? positions_->size() : (n_ + k_ - 1) / k_;
+  }
+
+  // the position of the given slot
+  xssr_always_inline uint64_t operator[](const uint64_t slot) const {
+    return (positions_ != nullptr) ? (*positions_)[slot] : slot * k_;
+  }
+};
+
+// pss[s] and nss[s] belong to the s-th sampled position (with the same
+// conventions as the arrays: pss[0] = pss[n - 1] = n, nss[0] = n - 1 and
+// nss[n - 1] = n); by default, the entries take 32 bits if n < 2^32 and 40
+// bits otherwise (see index_array.hpp), and any other index_type must be able
+// to hold n (std::invalid_argument otherwise)
+template <typename index_type = index_array>
+struct xss_sparse_result {
+  using array_type =
+      typename std::conditional<std::is_same<index_type, index_array>::value,
+                                index_array,
+                                std::vector<index_type>>::type;
+  array_type pss;
+  array_type nss;
+
+  xss_sparse_result() = default;
+
+  // a sample of the given size from a text of length n
+  xss_sparse_result(const uint64_t size, const uint64_t n) {
+    if constexpr (std::is_same<index_type, index_array>::value) {
+      pss = index_array(size, n);
+      nss = index_array(size, n);
+    } else {
+      check_index_type<index_type>(n);
+      pss.resize(size);
+      nss.resize(size);
+    }
+  }
+
+  xssr_always_inline void set_pss(const uint64_t slot, const uint64_t value) {
+    set(pss, slot, value);
+  }
+
+  xssr_always_inline void set_nss(const uint64_t slot, const uint64_t value) {
+    set(nss, slot, value);
+  }
+
+private:
+  xssr_always_inline static void
+  set(array_type& array, const uint64_t slot, const uint64_t value) {
+    if constexpr (std::is_same<index_type, index_array>::value)
+      array.set(slot, value);
+    else
+      array[slot] = value;
+  }
+};
+
+// Decodes the pss and nss of the sampled positions from the words of a bps
+// (in order). The open nodes are kept on a stack (the parent of a node is the
+// top of the stack when the node opens, and its nss is the next node when it
+// closes), and the slots of the sampled open nodes on a second stack.
+template <typename stack_type, typename index_type>
+class xss_sparse_decoder {
+private:
+  const xss_sample& sample_;
+  const uint64_t n_;
+  xss_sparse_result<index_type>& result_;
+
+  stack_type open_nodes_;
+  std::stack<uint64_t, std::vector<uint64_t>> open_slots_;
+  uint64_t next_slot_;
+  // number of opening parentheses, and depth (the virtual root has depth 1)
+  uint64_t opens_;
+  int64_t excess_;
+
+public:
+  xss_sparse_decoder(const xss_sample& sample,
+                     const uint64_t n,
+                     xss_sparse_result<index_type>& result)
+      : sample_(sample),
+        n_(n),
+        result_(result),
+        open_nodes_(n),
+        next_slot_(0),
+        opens_(0),
+        excess_(0) {
+    result_ = xss_sparse_result<index_type>(sample_.size(), n_);
+    // (the stack always contains node 0)
+    if (sample_.size() > 0 && sample_[0] == 0) {
+      result_.set_pss(0, n_);
+      result_.set_nss(0, n_ - 1);
+      ++next_slot_;
+    }
+  }
+
+  void operator()(const uint64_t* words, const uint64_t count) {
+    for (uint64_t w = 0; w < count; ++w) {
+      const uint64_t word = words[w];
+      for (uint64_t k = 0; k < 64; ++k) {
+        if (word & (word_left_one >> k)) {
+          open(++opens_ - 2);
+          ++excess_;
+        } else {
+          // (only the closing parentheses of nodes 1, ..., n - 1)
+          if (excess_ >= 3)
+            close();
+          --excess_;
+        }
+      }
+    }
+  }
+
+private:
+  xssr_always_inline void open(const uint64_t node) {
+    // (skip the virtual root and node 0)
+    if (xssr_unlikely(node + 1 < 2 || node >= n_))
+      return;
+    const bool sampled =
+        next_slot_ < sample_.size() && sample_[next_slot_] == node;
+    // (node n - 1 is a child of the virtual root)
+    if (xssr_unlikely(node + 1 == n_)) {
+      if (sampled) {
+        result_.set_pss(next_slot_, n_);
+        result_.set_nss(next_slot_++, n_);
+      }
+      return;
+    }
+    if (sampled) {
+      result_.set_pss(next_slot_, open_nodes_.top());
+      open_slots_.push(next_slot_++);
+    }
+    open_nodes_.push(node);
+  }
+
+  xssr_always_inline void close() {
+    const uint64_t node = open_nodes_.top();
+    open_nodes_.pop();
+    if (!open_slots_.empty() && sample_[open_slots_.top()] == node) {
+      result_.set_nss(open_slots_.top(), opens_ - 1);
+      open_slots_.pop();
+    }
+  }
+};
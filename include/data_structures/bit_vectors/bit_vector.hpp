@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
+#include <new>
 #include <sstream>
 #include <util/common.hpp>
 
@@ -36,12 +38,15 @@ private:
   uint64_t n_;
   uint64_t data_size_;
   uint64_t* data_;
+  // number of allocated words (at least data_size_, see resize)
+  uint64_t capacity_;
 
 public:
   bit_vector(const uint64_t n, const bit_vector_init init)
       : n_(n),
         data_size_(div64((n_ + 63 + 64))),
-        data_(static_cast<uint64_t*>(malloc(mul8(data_size_)))) {
+        data_(static_cast<uint64_t*>(malloc(mul8(data_size_)))),
+        capacity_(data_size_) {
 
     if (init == BV_FILL_ZERO)
       memset(data_, 0, mul8(data_size_));
@@ -50,7 +55,33 @@ public:
   }
 
   ~bit_vector() {
-    delete data_;
+    free(data_);
+  }
+
+  // changes the number of bits to n; the bits below min(n, size()) are kept,
+  // and all words that are added behind the old data_size() are zero (the
+  // storage at least doubles whenever it has to grow, such that a sequence of
+  // growing resizes takes amortized constant time per word). when shrinking,
+  // the bits behind n are cleared, since operator== compares whole words
+  void resize(const uint64_t n) {
+    const uint64_t data_size = div64(n + 63 + 64);
+    if (data_size > capacity_) {
+      const uint64_t capacity = std::max(data_size, 2 * capacity_);
+      const auto data =
+          static_cast<uint64_t*>(realloc(data_, mul8(capacity)));
+      if (data == nullptr)
+        throw std::bad_alloc();
+      data_ = data;
+      capacity_ = capacity;
+    }
+    if (data_size > data_size_)
+      memset(data_ + data_size_, 0, mul8(data_size - data_size_));
+    if (n < n_) {
+      data_[div64(n)] &= ~(word_all_one >> mod64(n));
+      memset(data_ + div64(n) + 1, 0, mul8(data_size - div64(n) - 1));
+    }
+    n_ = n;
+    data_size_ = data_size;
   }
 
   xssr_always_inline void set_one(const uint64_t idx) {
@@ -61,6 +92,31 @@ public:
     data_[div64(idx)] &= ~(word_left_one >> (mod64(idx)));
   }
 
+  // sets the bits first, first + distance, ..., first + (count - 1) * distance
+  xssr_always_inline void set_ones_periodic(const uint64_t first,
+                                            const uint64_t distance,
+                                            const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    const uint64_t last = first + (count - 1) * distance;
+    if (distance > 63) {
+      for (uint64_t idx = first; idx <= last; idx += distance)
+        set_one(idx);
+      return;
+    }
+    const uint64_t pattern = periodic_word(distance);
+    const uint64_t last_word_idx = div64(last);
+    uint64_t word_idx = div64(first);
+    uint64_t offset = mod64(first);
+    while (word_idx < last_word_idx) {
+      data_[word_idx++] |= pattern >> offset;
+      // position of the first one in the next word
+      offset = distance - 1 - (63 - offset) % distance;
+    }
+    data_[word_idx] |=
+        (pattern >> offset) & (word_all_one << (63 - mod64(last)));
+  }
+
   template <bool value>
   xssr_always_inline void set(const uint64_t idx) {
     if constexpr (value)
@@ -159,10 +215,12 @@ public:
     n_ = other.n_;
     data_size_ = other.data_size_;
     std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
     return (*this);
   }
 
-  bit_vector(bit_vector&& other) {
+  bit_vector(bit_vector&& other)
+      : n_(0), data_size_(0), data_(nullptr), capacity_(0) {
     (*this) = std::move(other);
   }
 
@@ -0,0 +1,220 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <util/common.hpp>
+
+// Sink that writes the words of a bps to a binary file (native byte order,
+// same layout as bit_vector::data()). The file can be read back, so words that
+// already left the window of a bps_stream remain accessible.
+class bps_file_sink {
+private:
+  std::FILE* file_;
+  uint64_t words_written_;
+
+public:
+  bps_file_sink(const std::string& path)
+      : file_(std::fopen(path.c_str(), "w+b")), words_written_(0) {
+    if (file_ == nullptr)
+      throw std::runtime_error("Could not open " + path + " for writing.");
+  }
+
+  // anonymous temporary file (removed automatically when it is closed)
+  bps_file_sink() : file_(std::tmpfile()), words_written_(0) {
+    if (file_ == nullptr)
+      throw std::runtime_error("Could not create a temporary file.");
+  }
+
+  ~bps_file_sink() {
+    std::fclose(file_);
+  }
+
+  void write(const uint64_t* words, const uint64_t count) {
+    std::fseek(file_, mul8(words_written_), SEEK_SET);
+    if (std::fwrite(words, sizeof(uint64_t), count, file_) != count)
+      throw std::runtime_error("Could not write bps to file.");
+    words_written_ += count;
+  }
+
+  void read(uint64_t* words, const uint64_t word_idx, const uint64_t count) {
+    std::fflush(file_);
+    std::fseek(file_, mul8(word_idx), SEEK_SET);
+    if (std::fread(words, sizeof(uint64_t), count, file_) != count)
+      throw std::runtime_error("Could not read bps from file.");
+  }
+
+  uint64_t words_written() const {
+    return words_written_;
+  }
+
+  bps_file_sink(const bps_file_sink&) = delete;
+  bps_file_sink& operator=(const bps_file_sink&) = delete;
+};
+
+// Sink that hands the words of a bps to a callback f(words, count). The words
+// are also spilled to a temporary file, such that lookaheads and run
+// extensions can still copy from words that already left the window (this
+// keeps the running time linear, no matter how large the period of a run is
+// compared to the window).
+template <typename callback_type>
+class bps_callback_sink {
+private:
+  callback_type callback_;
+  bps_file_sink spill_;
+
+public:
+  bps_callback_sink(callback_type callback) : callback_(callback) {}
+
+  void write(const uint64_t* words, const uint64_t count) {
+    callback_(words, count);
+    spill_.write(words, count);
+  }
+
+  void read(uint64_t* words, const uint64_t word_idx, const uint64_t count) {
+    spill_.read(words, word_idx, count);
+  }
+};
+
+// Bit vector that keeps only a window of its words in memory. When the window
+// is full, the first half of it is handed to the sink. Accesses use global
+// indices; only the window may be written.
+template <typename sink_type>
+class bps_stream {
+private:
+  constexpr static uint64_t cache_words_ = 1024;
+
+  const uint64_t n_;
+  const uint64_t data_size_;
+  uint64_t* data_;
+  sink_type& sink_;
+  uint64_t flushed_words_;
+
+  // cache for words that already left the window
+  uint64_t* cache_;
+  uint64_t cache_begin_;
+  uint64_t cache_end_;
+
+  xssr_always_inline uint64_t word(const uint64_t word_idx) const {
+    if (xssr_likely(word_idx >= flushed_words_))
+      return data_[word_idx - flushed_words_];
+    if (xssr_unlikely(word_idx < cache_begin_ || word_idx >= cache_end_)) {
+      auto self = const_cast<bps_stream*>(this);
+      self->cache_begin_ = word_idx - (word_idx % cache_words_);
+      self->cache_end_ =
+          std::min(cache_begin_ + cache_words_, flushed_words_);
+      self->sink_.read(cache_, cache_begin_, cache_end_ - cache_begin_);
+    }
+    return cache_[word_idx - cache_begin_];
+  }
+
+public:
+  constexpr static uint64_t default_window_words = 1ULL << 20;
+
+  bps_stream(const uint64_t n,
+             sink_type& sink,
+             const uint64_t window_words = default_window_words)
+      : n_(n),
+        data_size_(std::max(window_words, (uint64_t) 8)),
+        data_(static_cast<uint64_t*>(calloc(data_size_, sizeof(uint64_t)))),
+        sink_(sink),
+        flushed_words_(0),
+        cache_(static_cast<uint64_t*>(malloc(mul8(cache_words_)))),
+        cache_begin_(0),
+        cache_end_(0) {}
+
+  ~bps_stream() {
+    free(data_);
+    free(cache_);
+  }
+
+  // hands the first half of the window to the sink and moves the second half
+  // to the front; returns the number of flushed words
+  uint64_t flush() {
+    const uint64_t half = data_size_ / 2;
+    sink_.write(data_, half);
+    memmove(data_, data_ + half, mul8(data_size_ - half));
+    memset(data_ + data_size_ - half, 0, mul8(half));
+    flushed_words_ += half;
+    return half;
+  }
+
+  // hands all remaining words of the bps to the sink
+  void finish() {
+    const uint64_t total_words = div64(n_ + 63);
+    sink_.write(data_, total_words - flushed_words_);
+    flushed_words_ = total_words;
+  }
+
+  xssr_always_inline bool operator[](const uint64_t idx) const {
+    return word(div64(idx)) & (word_left_one >> (mod64(idx)));
+  }
+
+  xssr_always_inline uint64_t get_word(const uint64_t idx) const {
+    const uint64_t bit_idx = mod64(idx);
+    if (xssr_likely(bit_idx > 0))
+      return (word(div64(idx)) << bit_idx) |
+             (word(div64(idx) + 1) >> (64 - bit_idx));
+    else
+      return word(div64(idx));
+  }
+
+  xssr_always_inline void set_word(const uint64_t idx,
+                                   const uint64_t word) const {
+    const uint64_t bit_idx = mod64(idx);
+    const uint64_t word_idx = div64(idx) - flushed_words_;
+    if (xssr_likely(bit_idx > 0)) {
+      data_[word_idx] &= word_all_one << (64 - bit_idx);
+      data_[word_idx] |= word >> bit_idx;
+      data_[word_idx + 1] &= word_all_one >> bit_idx;
+      data_[word_idx + 1] |= word << (64 - bit_idx);
+    } else
+      data_[word_idx] = word;
+  }
+
+  xssr_always_inline uint64_t size() const {
+    return n_;
+  }
+
+  xssr_always_inline uint64_t* data() {
+    return data_;
+  }
+
+  xssr_always_inline uint64_t data_size() const {
+    return data_size_;
+  }
+
+  xssr_always_inline uint64_t flushed_words() const {
+    return flushed_words_;
+  }
+
+  bps_stream(const bps_stream&) = delete;
+  bps_stream& operator=(const bps_stream&) = delete;
+};
+
+template <typename bv_type>
+struct is_bps_stream : std::false_type {};
+
+template <typename sink_type>
+struct is_bps_stream<bps_stream<sink_type>> : std::true_type {};
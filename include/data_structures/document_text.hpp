@@ -0,0 +1,121 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <data_structures/lce/lce_naive.hpp>
+#include <util/common.hpp>
+
+// one document of a collection whose documents are stored back to back,
+// without separators (see xss_real::run_collection); the two sentinels around
+// the document are virtual, and reading them yields 0 (every other character
+// c is read as c + 1, such that the sentinels are smaller than all characters,
+// including 0; characters of 8 byte documents must be smaller than 2^64 - 1)
+template <typename value_type>
+struct document_symbol {};
+
+// behaves like a pointer to the document with its sentinels (text[i],
+// text + i), where text[1] is the first character of the document
+template <typename vt>
+class document_text_pointer {
+private:
+  const vt* data_;
+  uint64_t n_;
+  uint64_t offset_;
+
+public:
+  using value_type = document_symbol<vt>;
+
+  // n is the length of the document plus 2 (for the sentinels)
+  document_text_pointer(const vt* data,
+                        const uint64_t n,
+                        const uint64_t offset = 0)
+      : data_(data), n_(n), offset_(offset) {}
+
+  xssr_always_inline uint64_t operator[](const uint64_t i) const {
+    // (wraps around for the first sentinel)
+    const uint64_t idx = offset_ + i - 1;
+    if (xssr_unlikely(idx >= n_ - 2))
+      return 0;
+    return static_cast<uint64_t>(data_[idx]) + 1;
+  }
+
+  xssr_always_inline document_text_pointer operator+(const uint64_t i) const {
+    return document_text_pointer(data_, n_, offset_ + i);
+  }
+
+  // the character text[i] as it is stored (0 < i < n - 1)
+  xssr_always_inline vt character(const uint64_t i) const {
+    return data_[offset_ + i - 1];
+  }
+
+  // length of the document (including both sentinels)
+  xssr_always_inline uint64_t size() const {
+    return n_;
+  }
+};
+
+template <typename vt>
+struct text_pointer<document_symbol<vt>> {
+  using type = document_text_pointer<vt>;
+};
+
+// compares the stored characters; the lce is cut off at the virtual sentinels
+template <typename vt>
+class lce_naive<document_symbol<vt>> {
+public:
+  using pointer_type = document_text_pointer<vt>;
+
+  struct lce {
+    pointer_type text_;
+    lce(const pointer_type text) : text_(text) {}
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t lcp = 0) const {
+      if (xssr_unlikely(i == 0 || j == 0))
+        return lcp;
+      const uint64_t max_lcp = text_.size() - 1 - std::max(i, j);
+      while (lcp < max_lcp &&
+             text_.character(i + lcp) == text_.character(j + lcp))
+        ++lcp;
+      return lcp;
+    }
+  };
+
+  xssr_always_inline static lce get_lce(const pointer_type text,
+                                        [[maybe_unused]] const uint64_t n = 0) {
+    return lce(text);
+  }
+
+  template <uint64_t distance>
+  xssr_always_inline static lce
+  get_lce_prefetch(const pointer_type text,
+                   [[maybe_unused]] const uint64_t n = 0) {
+    return lce(text);
+  }
+
+  static std::string to_string() {
+    return "LCE_DOCUMENT";
+  }
+
+private:
+  lce_naive() {}
+};
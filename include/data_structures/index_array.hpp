@@ -0,0 +1,108 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <util/common.hpp>
+#include <util/integer_types.hpp>
+#include <vector>
+
+class index_array;
+
+// largest value that fits into index_type (index_array, uint40_t, or a
+// built-in unsigned integer type)
+template <typename index_type>
+constexpr uint64_t index_type_max() {
+  if constexpr (std::is_same<index_type, uint40_t>::value ||
+                std::is_same<index_type, index_array>::value)
+    return (1ULL << 40) - 1;
+  else
+    return std::numeric_limits<index_type>::max();
+}
+
+// throws std::invalid_argument if max_value does not fit into index_type
+template <typename index_type>
+void check_index_type(const uint64_t max_value) {
+  if (max_value > index_type_max<index_type>())
+    throw std::invalid_argument(
+        "The value " + std::to_string(max_value) + " does not fit into " +
+        std::to_string(8 * sizeof(index_type)) + " bit entries.");
+}
+
+// Array of text positions (or lengths) whose entries take 32 bits if all
+// values are smaller than 2^32, and 40 bits otherwise. The width is chosen
+// once, so every access is a single branch and a plain load.
+class index_array {
+private:
+  bool wide_;
+  std::vector<uint32_t> narrow_values_;
+  std::vector<uint40_t> wide_values_;
+
+public:
+  // true if values up to max_value need 40 bit entries
+  constexpr static bool is_wide(const uint64_t max_value) {
+    return max_value > index_type_max<uint32_t>();
+  }
+
+  index_array() : wide_(false) {}
+
+  index_array(const uint64_t size, const uint64_t max_value)
+      : wide_(is_wide(max_value)) {
+    check_index_type<uint40_t>(max_value);
+    if (wide_)
+      wide_values_.resize(size);
+    else
+      narrow_values_.resize(size);
+  }
+
+  explicit index_array(std::vector<uint32_t>&& values)
+      : wide_(false), narrow_values_(std::move(values)) {}
+
+  explicit index_array(std::vector<uint40_t>&& values)
+      : wide_(true), wide_values_(std::move(values)) {}
+
+  xssr_always_inline uint64_t operator[](const uint64_t idx) const {
+    return wide_ ? (uint64_t) wide_values_[idx] : narrow_values_[idx];
+  }
+
+  xssr_always_inline void set(const uint64_t idx, const uint64_t value) {
+    if (wide_)
+      wide_values_[idx] = value;
+    else
+      narrow_values_[idx] = value;
+  }
+
+  xssr_always_inline uint64_t size() const {
+    return wide_ ? wide_values_.size() : narrow_values_.size();
+  }
+
+  xssr_always_inline bool wide() const {
+    return wide_;
+  }
+
+  // number of bytes per entry
+  xssr_always_inline uint64_t entry_bytes() const {
+    return wide_ ? sizeof(uint40_t) : sizeof(uint32_t);
+  }
+};
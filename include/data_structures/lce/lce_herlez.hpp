@@ -26,12 +26,28 @@
 template <typename value_type = uint8_t>
 class lce_herlez {
 public:
+  // for integer alphabets, the LCE is computed on the bytes of the text
   template <typename vt>
   struct lce {
+    constexpr static uint64_t bytes = sizeof(vt);
     LcePrezza prezza_;
-    lce(vt* text, const uint64_t n) : prezza_(text, n) {}
+    lce(vt* text, const uint64_t n)
+        : prezza_(reinterpret_cast<uint8_t*>(text), n * bytes) {}
     xssr_always_inline uint64_t operator()(const uint64_t i, const uint64_t j) {
-      return prezza_.lce(i, j);
+      if constexpr (bytes == 1)
+        return prezza_.lce(i, j);
+      else
+        return prezza_.lce(bytes * i, bytes * j) / bytes;
+    }
+
+    // the text is overwritten by the fingerprints, but can be restored
+    xssr_always_inline vt character(const uint64_t i) {
+      vt result = 0;
+      for (uint64_t b = 0; b < bytes; ++b) {
+        const vt byte = (uint8_t) prezza_[bytes * i + b];
+        result |= byte << (8 * b);
+      }
+      return result;
     }
 
     lce(const lce&) = delete;
@@ -40,10 +56,16 @@ public:
 
   template <typename vt>
   struct suffix_compare {
-    LcePrezza prezza_;
-    suffix_compare(vt* text, const uint64_t n) : prezza_(text, n) {}
+    lce<vt> prezzalce_;
+    suffix_compare(vt* text, const uint64_t n) : prezzalce_(text, n) {}
     xssr_always_inline uint64_t operator()(const uint64_t i, const uint64_t j) {
-      return prezza_.isSmallerSuffix(i, j);
+      if constexpr (sizeof(vt) == 1) {
+        return prezzalce_.prezza_.isSmallerSuffix(i, j);
+      } else {
+        const uint64_t lce_result = prezzalce_(i, j);
+        return prezzalce_.character(i + lce_result) <
+               prezzalce_.character(j + lce_result);
+      }
     }
 
     suffix_compare(const suffix_compare&) = delete;
@@ -62,4 +84,75 @@ public:
 
 private:
   lce_herlez() {}
-};
\ No newline at end of file
+};
+// the text of an in-place lce after it has been overwritten by the
+// fingerprints (see xss_real_inplace.hpp); it behaves like a pointer to the
+// text, and decodes each character from the fingerprints
+template <typename value_type>
+struct herlez_symbol {};
+
+template <typename vt>
+class herlez_text_pointer {
+private:
+  constexpr static uint64_t bytes = sizeof(vt);
+
+  LcePrezza* prezza_;
+  uint64_t offset_;
+
+public:
+  using value_type = herlez_symbol<vt>;
+
+  herlez_text_pointer(LcePrezza* prezza, const uint64_t offset = 0)
+      : prezza_(prezza), offset_(offset) {}
+
+  xssr_always_inline vt operator[](const uint64_t i) const {
+    const uint64_t idx = bytes * (offset_ + i);
+    vt result = 0;
+    for (uint64_t b = 0; b < bytes; ++b) {
+      const vt byte = (uint8_t)(*prezza_)[idx + b];
+      result |= byte << (8 * b);
+    }
+    return result;
+  }
+
+  xssr_always_inline herlez_text_pointer operator+(const uint64_t i) const {
+    return herlez_text_pointer(prezza_, offset_ + i);
+  }
+
+  xssr_always_inline LcePrezza* prezza() const {
+    return prezza_;
+  }
+};
+
+template <typename vt>
+struct text_pointer<herlez_symbol<vt>> {
+  using type = herlez_text_pointer<vt>;
+};
+
+template <typename vt>
+class lce_herlez<herlez_symbol<vt>> {
+public:
+  struct lce {
+    constexpr static uint64_t bytes = sizeof(vt);
+    LcePrezza* prezza_;
+    lce(const herlez_text_pointer<vt> text) : prezza_(text.prezza()) {}
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           const uint64_t lcp = 0) const {
+      return lcp +
+             prezza_->lce(bytes * (i + lcp), bytes * (j + lcp)) / bytes;
+    }
+  };
+
+  xssr_always_inline static lce get_lce(const herlez_text_pointer<vt> text,
+                                        [[maybe_unused]] const uint64_t n = 0) {
+    return lce(text);
+  }
+
+  static std::string to_string() {
+    return "LCE_HERLEZ";
+  }
+
+private:
+  lce_herlez() {}
+};
@@ -39,21 +39,27 @@ public:
       return result;
     }
 
+    // for integer alphabets, the LCE is computed on the bytes of the text
+    constexpr static uint64_t bytes = sizeof(vt);
     LcePrezza prezza_;
     lce(const vt* text, const uint64_t n)
-        : text_(text), copy_(get_copy(text, n)), prezza_(copy_, n) {}
+        : text_(text),
+          copy_(get_copy(text, n)),
+          prezza_(reinterpret_cast<uint8_t*>(copy_), n * bytes) {}
 
     ~lce() {
       delete copy_;
     }
 
-    xssr_always_inline uint64_t operator()(const uint64_t i, const uint64_t j) {
-      uint64_t l = 0;
-      while (text_[i + l] == text_[j + l] && xssr_likely(l < 1000))
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t l = 0) {
+      const uint64_t naive_limit = l + 1000;
+      while (text_[i + l] == text_[j + l] && xssr_likely(l < naive_limit))
         ++l;
       return xssr_likely(text_[i + l] != text_[j + l])
                  ? l
-                 : (l + prezza_.lce(i + l, j + l));
+                 : (l + prezza_.lce(bytes * (i + l), bytes * (j + l)) / bytes);
     }
 
     lce(const lce&) = delete;
@@ -86,6 +92,10 @@ public:
     return suffix_compare(text, n);
   }
 
+  static std::string to_string() {
+    return "LCE_HERLEZ_1K";
+  }
+
 private:
   lce_herlez1k() {}
 };
\ No newline at end of file
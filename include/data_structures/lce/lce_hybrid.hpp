@@ -0,0 +1,217 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <util/common.hpp>
+#include <util/random.hpp>
+#include <vector>
+
+// compares the first naive_length characters naively, and then gallops over
+// karp-rabin fingerprints modulo the mersenne prime 2^61 - 1 (correct with
+// high probability). there is no preprocessing: the fingerprints of the
+// prefixes text[0, k * block) are computed on demand, up to the rightmost
+// position that any lce has touched so far, and need n / block words. each
+// probe of the gallop costs at most block character accesses.
+template <typename value_type = uint8_t>
+class lce_hybrid {
+  using text_type = text_pointer_t<value_type>;
+
+  constexpr static uint64_t naive_length = 256;
+  constexpr static uint64_t block = 128;
+  constexpr static uint64_t prime = (1ULL << 61) - 1;
+  static_assert(naive_length >= 2 * block);
+
+  xssr_always_inline static uint64_t mul(const uint64_t a, const uint64_t b) {
+    const __uint128_t p = static_cast<__uint128_t>(a) * b;
+    const uint64_t r = (static_cast<uint64_t>(p) & prime) +
+                       static_cast<uint64_t>(p >> 61);
+    return (r >= prime) ? (r - prime) : r;
+  }
+
+  xssr_always_inline static uint64_t add(const uint64_t a, const uint64_t b) {
+    const uint64_t r = a + b;
+    return (r >= prime) ? (r - prime) : r;
+  }
+
+  xssr_always_inline static uint64_t sub(const uint64_t a, const uint64_t b) {
+    return (a >= b) ? (a - b) : (a + prime - b);
+  }
+
+  template <typename vt>
+  xssr_always_inline static uint64_t symbol(const vt c) {
+    if constexpr (sizeof(value_type) < 8)
+      return static_cast<uint64_t>(c);
+    else
+      return static_cast<uint64_t>(c) % prime;
+  }
+
+  // the sampled prefix fingerprints, shared by all copies of an lce (and
+  // therefore by all threads of xss_real::run_parallel): sampled_ is
+  // allocated once, and entries up to frontier_ are never written again
+  struct fingerprints {
+    const text_type text_;
+    const uint64_t base_;
+    std::vector<uint64_t> sampled_;
+    std::atomic<uint64_t> frontier_;
+    std::mutex mutex_;
+    // power_[e] = base^(2^e)
+    uint64_t power_[64];
+
+    fingerprints(const text_type text, const uint64_t n)
+        : text_(text),
+          base_(2 + get_random_seed() % (prime - 3)),
+          sampled_(n / block + 1),
+          frontier_(0) {
+      sampled_[0] = 0;
+      power_[0] = base_;
+      for (uint64_t e = 1; e < 64; ++e)
+        power_[e] = mul(power_[e - 1], power_[e - 1]);
+    }
+
+    xssr_always_inline uint64_t power(uint64_t exponent) const {
+      uint64_t result = 1;
+      for (uint64_t e = 0; exponent > 0; ++e, exponent >>= 1) {
+        if (exponent & 1)
+          result = mul(result, power_[e]);
+      }
+      return result;
+    }
+
+    // makes sampled_[k] available
+    xssr_always_inline void extend(const uint64_t k) {
+      if (xssr_likely(k <= frontier_.load(std::memory_order_acquire)))
+        return;
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint64_t f = frontier_.load(std::memory_order_relaxed);
+      for (; f < k; ++f) {
+        uint64_t fp = sampled_[f];
+        for (uint64_t t = f * block; t < (f + 1) * block; ++t)
+          fp = add(mul(fp, base_), symbol(text_[t]));
+        sampled_[f + 1] = fp;
+      }
+      frontier_.store(f, std::memory_order_release);
+    }
+
+    // fingerprint of text[0, x)
+    xssr_always_inline uint64_t prefix(const uint64_t x) {
+      const uint64_t k = x / block;
+      extend(k);
+      uint64_t fp = sampled_[k];
+      for (uint64_t t = k * block; t < x; ++t)
+        fp = add(mul(fp, base_), symbol(text_[t]));
+      return fp;
+    }
+  };
+
+public:
+  struct lce {
+    const text_type text_;
+    const uint64_t n_;
+    std::shared_ptr<fingerprints> fp_;
+
+    lce(const text_type text, const uint64_t n)
+        : text_(text), n_(n), fp_(std::make_shared<fingerprints>(text, n)) {}
+
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t lcp = 0) const {
+      const uint64_t naive_limit = lcp + naive_length;
+      while (text_[i + lcp] == text_[j + lcp]) {
+        if (xssr_unlikely(++lcp == naive_limit))
+          return gallop(i, j, lcp);
+      }
+      return lcp;
+    }
+
+  private:
+    // the probed lengths len are such that i + len is a multiple of block,
+    // i.e. the fingerprint of text[0, i + len) is a sample. text[n - 1] is
+    // the unique smallest symbol, which bounds the lce by max_lcp
+    uint64_t gallop(const uint64_t i, const uint64_t j, uint64_t lcp) const {
+      auto& fp = *fp_;
+      const uint64_t max_lcp = n_ - 1 - std::max(i, j);
+      const uint64_t fp_i = fp.prefix(i);
+      const uint64_t fp_j = fp.prefix(j);
+      const auto equal = [&](const uint64_t k) {
+        const uint64_t len = k * block - i;
+        const uint64_t shift = fp.power(len);
+        return sub(fp.prefix(i + len), mul(fp_i, shift)) ==
+               sub(fp.prefix(j + len), mul(fp_j, shift));
+      };
+
+      // text[i, lo * block) matches, and text[i, hi * block) does not (if hi
+      // is larger than lo)
+      uint64_t lo = (i + lcp) / block;
+      uint64_t hi = lo;
+      const uint64_t max_k = (i + max_lcp) / block;
+      for (uint64_t step = naive_length / block; lo < max_k; step <<= 1) {
+        hi = std::min(lo + step, max_k);
+        if (!equal(hi))
+          break;
+        lo = hi;
+      }
+      while (hi - lo > 1) {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        if (equal(mid))
+          lo = mid;
+        else
+          hi = mid;
+      }
+      lcp = std::max(lcp, lo * block - i);
+      while (text_[i + lcp] == text_[j + lcp])
+        ++lcp;
+      return lcp;
+    }
+  };
+
+  struct suffix_compare {
+    const text_type text_;
+    lce lce_;
+    suffix_compare(const text_type text, const uint64_t n)
+        : text_(text), lce_(text, n) {}
+
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j) const {
+      const uint64_t lce_result = lce_(i, j);
+      return text_[i + lce_result] < text_[j + lce_result];
+    }
+  };
+
+  xssr_always_inline static lce get_lce(const text_type text,
+                                        const uint64_t n) {
+    return lce(text, n);
+  }
+
+  xssr_always_inline static suffix_compare
+  get_suffix_compare(const text_type text, const uint64_t n) {
+    return suffix_compare(text, n);
+  }
+
+  static std::string to_string() {
+    return "LCE_HYBRID";
+  }
+
+private:
+  lce_hybrid() {}
+};
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <util/common.hpp>
 
 template <typename value_type = uint8_t>
@@ -35,6 +36,49 @@ public:
         ++lcp;
       return lcp;
     }
+
+    // min(lce(i, j), limit), comparing at most limit characters
+    xssr_always_inline uint64_t capped(const uint64_t i,
+                                       const uint64_t j,
+                                       const uint64_t limit) const {
+      uint64_t lcp = 0;
+      while (lcp < limit && text_[i + lcp] == text_[j + lcp])
+        ++lcp;
+      return lcp;
+    }
+  };
+
+  // compares cache line by cache line, and prefetches both streams distance
+  // characters ahead of the current cache line (the prefetches may point
+  // behind the end of the text, which is harmless)
+  template <uint64_t distance>
+  struct lce_prefetch {
+    constexpr static uint64_t line =
+        std::max<uint64_t>(64 / sizeof(value_type), 1);
+    const value_type* text_;
+    lce_prefetch(const value_type* text) : text_(text) {}
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t lcp = 0) const {
+      while (true) {
+        __builtin_prefetch(text_ + i + lcp + distance);
+        __builtin_prefetch(text_ + j + lcp + distance);
+        for (uint64_t k = 0; k < line; ++k, ++lcp) {
+          if (text_[i + lcp] != text_[j + lcp])
+            return lcp;
+        }
+      }
+    }
+
+    // min(lce(i, j), limit), comparing at most limit characters
+    xssr_always_inline uint64_t capped(const uint64_t i,
+                                       const uint64_t j,
+                                       const uint64_t limit) const {
+      uint64_t lcp = 0;
+      while (lcp < limit && text_[i + lcp] == text_[j + lcp])
+        ++lcp;
+      return lcp;
+    }
   };
 
   struct suffix_compare {
@@ -54,12 +98,23 @@ public:
     return lce(text);
   }
 
+  template <uint64_t distance>
+  xssr_always_inline static lce_prefetch<distance>
+  get_lce_prefetch(const value_type* text,
+                   [[maybe_unused]] const uint64_t n = 0) {
+    return lce_prefetch<distance>(text);
+  }
+
   xssr_always_inline static suffix_compare
   get_suffix_compare(const value_type* text,
                      [[maybe_unused]] const uint64_t n = 0) {
     return suffix_compare(text);
   }
 
+  static std::string to_string() {
+    return "LCE_NAIVE";
+  }
+
 private:
   lce_naive() {}
 };
\ No newline at end of file
@@ -29,7 +29,10 @@ public:
   struct lce {
     rklce::rk_lce rk_lce_;
     lce(const value_type* text, const uint64_t n) : rk_lce_(text, n) {}
-    xssr_always_inline uint64_t operator()(const uint64_t i, const uint64_t j) {
+    // (a known common prefix does not speed up the query)
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           [[maybe_unused]] uint64_t lcp = 0) {
       return rk_lce_.LCE(i, j);
     }
   };
@@ -55,6 +58,10 @@ public:
     return suffix_compare(text, n);
   }
 
+  static std::string to_string() {
+    return "LCE_PREZZA";
+  }
+
 private:
   lce_prezza() {}
 };
\ No newline at end of file
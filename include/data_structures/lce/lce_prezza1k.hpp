@@ -31,9 +31,11 @@ public:
     rklce::rk_lce rk_lce_;
     lce(const value_type* text, const uint64_t n)
         : text_(text), rk_lce_(text, n) {}
-    xssr_always_inline uint64_t operator()(const uint64_t i, const uint64_t j) {
-      uint64_t l = 0;
-      while (text_[i + l] == text_[j + l] && xssr_likely(l < 1000))
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t l = 0) {
+      const uint64_t naive_limit = l + 1000;
+      while (text_[i + l] == text_[j + l] && xssr_likely(l < naive_limit))
         ++l;
       return xssr_likely(text_[i + l] != text_[j + l])
                  ? l
@@ -62,6 +64,10 @@ public:
     return suffix_compare(text, n);
   }
 
+  static std::string to_string() {
+    return "LCE_PREZZA_1K";
+  }
+
 private:
   lce_prezza1k() {}
 };
\ No newline at end of file
@@ -41,12 +41,14 @@
  * Modified on: Jun 4, 2019
  *      Author: Jonas Ellert
  *
- * Changes: Allow byte vector as input, inline everything
+ * Changes: Allow byte vector as input, inline everything, allow integer
+ *          alphabets (2, 4 and 8 byte characters)
  */
 
 #ifndef INTERNAL_RK_LCE_HPP_
 #define INTERNAL_RK_LCE_HPP_
 
+#include <algorithm>
 #include <data_structures/lce/rk/rk_lce_bin.hpp>
 #include <includes.hpp>
 
@@ -63,17 +65,16 @@ public:
    */
   template <typename value_type>
   rk_lce(const value_type* text, const uint64_t n) {
-    static_assert(sizeof(value_type) == 1);
-
-    char_to_uint = vector<uint8_t>(256);
-    uint_to_char = vector<char>(256);
 
     // DETECT ALPHABET
 
     // alphabet size. To be rounded to the next power of 2
 
-    int sigma_temp = 0;
-    {
+    uint64_t sigma_temp = 0;
+    if constexpr (sizeof(value_type) == 1) {
+
+      char_to_uint = vector<uint8_t>(256);
+      uint_to_char = vector<uint64_t>(256);
 
       vector<bool> mapped(256, false);
 
@@ -89,8 +90,27 @@ public:
           sigma_temp++;
         }
       }
+    } else {
+
+      // integer alphabet: map each character to its rank among the
+      // distinct characters of the text
+      vector<value_type> characters(text, text + n);
+      std::sort(characters.begin(), characters.end());
+      characters.erase(std::unique(characters.begin(), characters.end()),
+                       characters.end());
+      uint_to_char = vector<uint64_t>(characters.begin(), characters.end());
+      sigma_temp = uint_to_char.size();
     }
 
+    const auto encode = [&](const value_type c) -> uint64_t {
+      if constexpr (sizeof(value_type) == 1)
+        return char_to_uint[c];
+      else
+        return std::lower_bound(uint_to_char.begin(), uint_to_char.end(),
+                                (uint64_t) c) -
+               uint_to_char.begin();
+    };
+
     assert(sigma_temp > 0);
 
     sigma = 1;
@@ -119,11 +139,11 @@ public:
       for (uint64_t i = 0; i < n; ++i) {
 
         // char encoding
-        auto bc = char_to_uint[text[i]];
+        const uint64_t bc = encode(text[i]);
 
         for (int j = 0; j < log2_sigma; ++j) {
 
-          bool b = (bc >> (log2_sigma - j - 1)) & uint8_t(1);
+          bool b = (bc >> (log2_sigma - j - 1)) & uint64_t(1);
           binary_text.push_back(b);
         }
       }
@@ -139,7 +159,7 @@ public:
    * complexity: O(1)
    *
    */
-  xssr_always_inline char operator[](uint64_t i) {
+  xssr_always_inline uint64_t operator[](uint64_t i) {
 
     auto ib = i * log2_sigma + pad;
 
@@ -235,13 +255,13 @@ public:
     return n;
   }
 
-  xssr_always_inline uint16_t alphabet_size() {
+  xssr_always_inline uint64_t alphabet_size() {
     return sigma;
   }
 
 private:
   vector<uint8_t> char_to_uint;
-  vector<char> uint_to_char;
+  vector<uint64_t> uint_to_char;
 
   // text length
   uint64_t n;
@@ -251,7 +271,7 @@ private:
   uint64_t pad;
 
   // power of 2 immediately greater than or equal to alphabet size
-  uint16_t sigma;
+  uint64_t sigma;
 
   // log_2(sigma)
   uint16_t log2_sigma;
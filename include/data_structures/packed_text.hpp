@@ -0,0 +1,196 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <data_structures/lce/lce_naive.hpp>
+#include <stdexcept>
+#include <util/common.hpp>
+#include <vector>
+
+// texts over small alphabets, with bits = 2 (e.g. dna) or bits = 4 (e.g.
+// iupac codes) bits per character; the characters are replaced by their rank
+// in the alphabet of the text (which keeps the order of all suffixes)
+//
+// only the characters between the two sentinels are stored: the sentinels are
+// virtual, and reading them yields 0 (every other character is read as its
+// rank plus one)
+template <uint64_t bits>
+struct packed_symbol {
+  static_assert(bits == 2 || bits == 4);
+};
+
+// behaves like a pointer to the text (text[i], text + i); the characters are
+// stored left to right, starting with the most significant bits of a word
+template <uint64_t bits>
+class packed_text_pointer {
+private:
+  constexpr static uint64_t mask = (1ULL << bits) - 1;
+
+  const uint64_t* data_;
+  uint64_t n_;
+  uint64_t offset_;
+
+public:
+  using value_type = packed_symbol<bits>;
+  constexpr static uint64_t chars_per_word = 64 / bits;
+
+  packed_text_pointer(const uint64_t* data,
+                      const uint64_t n,
+                      const uint64_t offset = 0)
+      : data_(data), n_(n), offset_(offset) {}
+
+  xssr_always_inline uint8_t operator[](const uint64_t i) const {
+    // (wraps around for the first sentinel)
+    const uint64_t idx = offset_ + i - 1;
+    if (xssr_unlikely(idx >= n_ - 2))
+      return 0;
+    const uint64_t bit_idx = idx * bits;
+    return ((data_[div64(bit_idx)] >> (64 - bits - mod64(bit_idx))) & mask) +
+           1;
+  }
+
+  xssr_always_inline packed_text_pointer operator+(const uint64_t i) const {
+    return packed_text_pointer(data_, n_, offset_ + i);
+  }
+
+  // the chars_per_word characters (ranks) starting at text position idx > 0,
+  // in the same layout as the data (the characters behind the end of the
+  // text are zero)
+  xssr_always_inline uint64_t get_word(const uint64_t idx) const {
+    const uint64_t bit_idx = (offset_ + idx - 1) * bits;
+    const uint64_t word_idx = div64(bit_idx);
+    const uint64_t shift = mod64(bit_idx);
+    if (xssr_likely(shift > 0))
+      return (data_[word_idx] << shift) |
+             (data_[word_idx + 1] >> (64 - shift));
+    return data_[word_idx];
+  }
+
+  // length of the text (including both sentinels)
+  xssr_always_inline uint64_t size() const {
+    return n_;
+  }
+};
+
+template <uint64_t bits>
+class packed_text {
+private:
+  constexpr static uint64_t sigma = 1ULL << bits;
+
+  uint64_t n_;
+  std::vector<uint64_t> data_;
+
+public:
+  // text[0] and text[n - 1] are the sentinels; throws std::invalid_argument
+  // if the text has more than 2^bits different characters
+  template <typename value_type>
+  packed_text(const value_type* text, const uint64_t n)
+      : n_(n), data_(div64((n - 2) * bits + 63) + 2, 0) {
+    std::vector<value_type> alphabet;
+    for (uint64_t i = 1; i < n - 1; ++i) {
+      if (std::find(alphabet.begin(), alphabet.end(), text[i]) ==
+          alphabet.end()) {
+        if (alphabet.size() == sigma)
+          throw std::invalid_argument(
+              "The text has more than " + std::to_string(sigma) +
+              " different characters, which do not fit into " +
+              std::to_string(bits) + " bits.");
+        alphabet.push_back(text[i]);
+      }
+    }
+    std::sort(alphabet.begin(), alphabet.end());
+
+    for (uint64_t i = 1; i < n - 1; ++i) {
+      const uint64_t rank =
+          std::lower_bound(alphabet.begin(), alphabet.end(), text[i]) -
+          alphabet.begin();
+      const uint64_t bit_idx = (i - 1) * bits;
+      data_[div64(bit_idx)] |= rank << (64 - bits - mod64(bit_idx));
+    }
+  }
+
+  xssr_always_inline packed_text_pointer<bits> pointer() const {
+    return packed_text_pointer<bits>(data_.data(), n_);
+  }
+
+  // length of the text (including both sentinels)
+  xssr_always_inline uint64_t size() const {
+    return n_;
+  }
+
+  xssr_always_inline uint64_t bytes() const {
+    return mul8(data_.size());
+  }
+};
+
+template <uint64_t bits>
+struct text_pointer<packed_symbol<bits>> {
+  using type = packed_text_pointer<bits>;
+};
+
+// compares chars_per_word characters per step (xor of the two words, and the
+// leading zeros of the result); the lce is cut off at the virtual sentinels
+template <uint64_t bits>
+class lce_naive<packed_symbol<bits>> {
+public:
+  using pointer_type = packed_text_pointer<bits>;
+
+  struct lce {
+    pointer_type text_;
+    lce(const pointer_type text) : text_(text) {}
+    xssr_always_inline uint64_t operator()(const uint64_t i,
+                                           const uint64_t j,
+                                           uint64_t lcp = 0) const {
+      if (xssr_unlikely(i == 0 || j == 0))
+        return lcp;
+      const uint64_t max_lcp = text_.size() - 1 - std::max(i, j);
+      while (lcp < max_lcp) {
+        const uint64_t diff = text_.get_word(i + lcp) ^ text_.get_word(j + lcp);
+        if (diff != 0)
+          return std::min(lcp + __builtin_clzll(diff) / bits, max_lcp);
+        lcp += pointer_type::chars_per_word;
+      }
+      return max_lcp;
+    }
+  };
+
+  xssr_always_inline static lce get_lce(const pointer_type text,
+                                        [[maybe_unused]] const uint64_t n = 0) {
+    return lce(text);
+  }
+
+  // (the words are read sequentially, and the hardware prefetcher handles
+  // this pattern well)
+  template <uint64_t distance>
+  xssr_always_inline static lce
+  get_lce_prefetch(const pointer_type text,
+                   [[maybe_unused]] const uint64_t n = 0) {
+    return lce(text);
+  }
+
+  static std::string to_string() {
+    return "LCE_PACKED_" + std::to_string(bits);
+  }
+
+private:
+  lce_naive() {}
+};
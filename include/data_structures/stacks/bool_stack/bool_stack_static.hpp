@@ -72,6 +72,22 @@ public:
     push<true>();
   }
 
+  // pushes count times true
+  xssr_always_inline void push_true_run(uint64_t count) {
+    while (count > 0) {
+      const uint64_t fit = std::min(count, 63 - micro_idx_);
+      if (fit > 0) {
+        word_ |= (word_all_one << (64 - fit)) >> (micro_idx_ + 1);
+        micro_idx_ += fit;
+        count -= fit;
+      }
+      if (count > 0) {
+        push<true>();
+        --count;
+      }
+    }
+  }
+
   xssr_always_inline void push_false() {
     push<false>();
   }
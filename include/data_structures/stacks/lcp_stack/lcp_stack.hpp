@@ -24,10 +24,14 @@
 #include <data_structures/stacks/lcp_stack/lcp_stack_delta.hpp>
 #include <data_structures/stacks/lcp_stack/lcp_stack_naive.hpp>
 
+// with index_type = uint32_t, the naive and buffered stacks (and the jumps of
+// the dynamic stacks) use half the memory; all indices and lcps must be less
+// than 2^32 - 1
 template <stack_strategy strategy,
           typename ctz_type,
           bool use_delta_type,
-          typename value_type>
+          typename value_type,
+          typename index_type = uint64_t>
 class lcp_stack {
 private:
   lcp_stack() {}
@@ -38,19 +42,24 @@ public:
 
   using type_unbuffered =
       typename std::conditional<strategy_unbuffered == NAIVE,
-                                lcp_stack_naive,
+                                lcp_stack_naive<index_type>,
                                 lcp_stack_delta<strategy_unbuffered,
                                                 ctz_type,
                                                 use_delta_type,
-                                                value_type>>::type;
+                                                value_type,
+                                                index_type>>::type;
 
   using type = typename std::conditional<
       strategy == DYNAMIC_BUFFERED,
-      lcp_stack_buffered<
-          lcp_stack_delta<DYNAMIC, ctz_type, use_delta_type, value_type>>,
+      lcp_stack_buffered<lcp_stack_delta<DYNAMIC,
+                                         ctz_type,
+                                         use_delta_type,
+                                         value_type,
+                                         index_type>,
+                         index_type>,
       type_unbuffered>::type;
 
-  static type get_instance([[maybe_unused]] const value_type* text,
+  static type get_instance([[maybe_unused]] text_pointer_t<value_type> text,
                            [[maybe_unused]] const uint8_t delta,
                            [[maybe_unused]] const uint64_t n) {
     return type(n, delta, text);
@@ -24,7 +24,7 @@
 #include <deque>
 #include <util/common.hpp>
 
-template <typename lcp_stack_type>
+template <typename lcp_stack_type, typename index_type = uint64_t>
 class lcp_stack_buffered {
 private:
   const uint64_t buffer_size_;
@@ -32,8 +32,8 @@ private:
 
   lcp_stack_type lcp_stack_;
 
-  std::deque<uint64_t> indices_;
-  std::deque<uint64_t> lcps_;
+  std::deque<index_type> indices_;
+  std::deque<index_type> lcps_;
 
   uint64_t size_ = 0;
 
@@ -45,10 +45,10 @@ private:
   }
 
 public:
-  template <typename value_type>
+  template <typename text_type>
   lcp_stack_buffered(const uint64_t n,
                      const uint64_t delta,
-                     const value_type* text)
+                     const text_type text)
       : buffer_size_(get_max_size(n)),
         half_buffer_size_(buffer_size_ >> 1),
         lcp_stack_(n, delta, text) {
@@ -56,6 +56,12 @@ public:
     lcps_.push_front(0ULL);
   }
 
+  // (the stack must only contain the sentinel)
+  template <typename text_type>
+  xssr_always_inline void reset(const text_type text, const uint64_t n) {
+    lcp_stack_.reset(text, n);
+  }
+
   xssr_always_inline uint64_t top_idx() const {
     return indices_.back();
   }
@@ -83,6 +89,16 @@ public:
     }
   }
 
+  // pushes the indices idx, idx + period, ... (count many) with the lcps
+  // lcp, lcp - period, ... (the lcps must not become negative)
+  xssr_always_inline void push_run(const uint64_t idx,
+                                   const uint64_t period,
+                                   const uint64_t lcp,
+                                   const uint64_t count) {
+    for (uint64_t k = 0; k < count; ++k)
+      push_with_lcp(idx + k * period, lcp - k * period);
+  }
+
   xssr_always_inline void push_without_lcp(const uint64_t idx) {
     indices_.push_back(idx);
   }
@@ -26,8 +26,9 @@
 template <stack_strategy strategy,
           typename ctz_type,
           bool use_delta_type,
-          typename value_type>
-using lcp_stack_delta =
-    typename std::conditional<use_delta_type,
-                              lcp_stack_delta_x<strategy, ctz_type, value_type>,
-                              lcp_stack_delta_0<strategy, ctz_type>>::type;
\ No newline at end of file
+          typename value_type,
+          typename index_type = uint64_t>
+using lcp_stack_delta = typename std::conditional<
+    use_delta_type,
+    lcp_stack_delta_x<strategy, ctz_type, value_type, index_type>,
+    lcp_stack_delta_0<strategy, ctz_type, index_type>>::type;
\ No newline at end of file
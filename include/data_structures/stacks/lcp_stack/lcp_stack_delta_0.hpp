@@ -25,11 +25,13 @@
 #include <data_structures/stacks/unary_stack/unary_stack.hpp>
 #include <util/common.hpp>
 
-template <stack_strategy strategy, typename ctz_type>
+template <stack_strategy strategy,
+          typename ctz_type,
+          typename index_type = uint64_t>
 class lcp_stack_delta_0 {
 private:
   constexpr static uint64_t minimum_n = 4096;
-  telescope_stack<strategy, ctz_type> indices_;
+  telescope_stack<strategy, ctz_type, index_type> indices_;
   unary_stack<strategy, ctz_type> lcps_;
   bool_stack<strategy> type_stack_;
   uint64_t top_lcp_;
@@ -44,6 +46,9 @@ public:
     static_assert(strategy == STATIC || strategy == DYNAMIC);
   }
 
+  template <typename... dummy_types>
+  xssr_always_inline void reset(const dummy_types&...) {}
+
   xssr_always_inline void push_with_lcp(const uint64_t idx,
                                         const uint64_t lcp) {
     indices_.push(idx);
@@ -58,6 +63,22 @@ public:
     top_lcp_ = lcp;
   }
 
+  // pushes the indices idx, idx + period, ... (count many) with the lcps
+  // lcp, lcp - period, ... (the lcps must not become negative)
+  xssr_always_inline void push_run(const uint64_t idx,
+                                   const uint64_t period,
+                                   const uint64_t lcp,
+                                   const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push_with_lcp(idx, lcp);
+    // all further lcps are relative values (the difference is the period)
+    indices_.push_run(idx + period, period, count - 1);
+    lcps_.push_run(period + 1, count - 1);
+    type_stack_.push_true_run(count - 1);
+    top_lcp_ = lcp - (count - 1) * period;
+  }
+
   xssr_always_inline void push_without_lcp(const uint64_t idx) {
     indices_.push(idx);
   }
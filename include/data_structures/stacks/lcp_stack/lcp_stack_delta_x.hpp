@@ -25,17 +25,20 @@
 #include <data_structures/stacks/unary_stack/unary_stack.hpp>
 #include <util/common.hpp>
 
-template <stack_strategy strategy, typename ctz_type, typename value_type>
+template <stack_strategy strategy,
+          typename ctz_type,
+          typename value_type,
+          typename index_type = uint64_t>
 class lcp_stack_delta_x {
 private:
   constexpr static uint64_t minimum_n = 4096;
-  const uint64_t n_;
+  uint64_t n_;
   const uint64_t log2_delta_;
   const uint64_t delta_;
 
-  const value_type* text_;
+  text_pointer_t<value_type> text_;
 
-  telescope_stack<strategy, ctz_type> indices_;
+  telescope_stack<strategy, ctz_type, index_type> indices_;
   unary_stack<strategy, ctz_type> lcps_;
   uint64_t v_stack_size_;
 
@@ -59,7 +62,7 @@ private:
 public:
   lcp_stack_delta_x(const uint64_t n,
                     const uint64_t delta,
-                    const value_type* text)
+                    text_pointer_t<value_type> text)
       : n_(n),
         log2_delta_((uint64_t) std::floor(std::log2(delta))),
         delta_(1ULL << log2_delta_),
@@ -76,6 +79,14 @@ public:
     }
   }
 
+  // switches to another text of at most the initial length
+  // (the stack must only contain the sentinel)
+  xssr_always_inline void reset(text_pointer_t<value_type> text,
+                                const uint64_t n) {
+    text_ = text;
+    n_ = n;
+  }
+
   xssr_always_inline void push_with_lcp(const uint64_t idx,
                                         const uint64_t lcp) {
     indices_.push(idx);
@@ -89,6 +100,24 @@ public:
     top_lcp_ = lcp;
   }
 
+  // pushes the indices idx, idx + period, ... (count many) with the lcps
+  // lcp, lcp - period, ... (the lcps must not become negative)
+  xssr_always_inline void push_run(const uint64_t idx,
+                                   const uint64_t period,
+                                   const uint64_t lcp,
+                                   const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push_with_lcp(idx, lcp);
+    // all further lcps are relative values (the difference is the period)
+    indices_.push_run(idx + period, period, count - 1);
+    if (is_relative_value(period, 0)) {
+      lcps_.push_run(period >> log2_delta_, count - 1);
+      v_stack_size_ += count - 1;
+    }
+    top_lcp_ = lcp - (count - 1) * period;
+  }
+
   xssr_always_inline void push_without_lcp(const uint64_t idx) {
     indices_.push(idx);
   }
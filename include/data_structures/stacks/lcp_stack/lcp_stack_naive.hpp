@@ -23,11 +23,12 @@
 #include <data_structures/stacks/naive_stack/naive_stack.hpp>
 #include <stack>
 
+template <typename index_type = uint64_t>
 class lcp_stack_naive {
 
 private:
-  naive_stack<uint64_t> indices_;
-  naive_stack<uint64_t> lcps_;
+  naive_stack<index_type> indices_;
+  naive_stack<index_type> lcps_;
 
   //  std::stack<uint64_t> indices_;
   //  std::stack<uint64_t> lcps_;
@@ -39,12 +40,27 @@ public:
     //    lcps_.push(0);
   }
 
+  template <typename... dummy_types>
+  xssr_always_inline void reset(const dummy_types&...) {}
+
   xssr_always_inline void push_with_lcp(const uint64_t idx,
                                         const uint64_t lcp) {
     indices_.push(idx);
     lcps_.push(lcp);
   }
 
+  // pushes the indices idx, idx + period, ... (count many) with the lcps
+  // lcp, lcp - period, ... (the lcps must not become negative)
+  xssr_always_inline void push_run(const uint64_t idx,
+                                   const uint64_t period,
+                                   const uint64_t lcp,
+                                   const uint64_t count) {
+    for (uint64_t k = 0; k < count; ++k) {
+      indices_.push(idx + k * period);
+      lcps_.push(lcp - k * period);
+    }
+  }
+
   xssr_always_inline void push_without_lcp(const uint64_t idx) {
     indices_.push(idx);
   }
@@ -66,6 +82,8 @@ public:
     return lcps_.top();
   }
 
-  lcp_stack_naive(const lcp_stack_naive&) = delete;
+  // (see xss_real_online.hpp)
+  lcp_stack_naive(const lcp_stack_naive& other)
+      : indices_(other.indices_), lcps_(other.lcps_) {}
   lcp_stack_naive& operator=(const lcp_stack_naive&) = delete;
 };
\ No newline at end of file
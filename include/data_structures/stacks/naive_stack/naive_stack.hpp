@@ -132,7 +132,9 @@ public:
     return data_.size();
   }
 
-  naive_stack_std(const naive_stack_std&) = delete;
+  // (the online mode continues on a copy of the stack, see
+  // xss_real_online.hpp)
+  naive_stack_std(const naive_stack_std& other) : data_(other.data_) {}
   naive_stack_std& operator=(const naive_stack_std&) = delete;
 
   naive_stack_std& operator=(naive_stack_std&& other) {
@@ -25,15 +25,20 @@
 #include <data_structures/stacks/telescope_stack/telescope_stack_dynamic.hpp>
 #include <data_structures/stacks/telescope_stack/telescope_stack_static.hpp>
 
-template <stack_strategy strategy, typename ctz_type>
+// index_type is the type of the stored values (uint32_t suffices if all
+// values are less than 2^32 - 1); the static stack stores everything inside
+// of its bit vector and ignores it
+template <stack_strategy strategy,
+          typename ctz_type,
+          typename index_type = uint64_t>
 using telescope_stack = typename std::conditional<
     (strategy == DYNAMIC || strategy == STATIC),
     typename std::conditional<strategy == DYNAMIC,
-                              telescope_stack_dynamic<ctz_type>,
+                              telescope_stack_dynamic<ctz_type, index_type>,
                               telescope_stack_static<ctz_type>>::type,
-    typename std::conditional<strategy == DYNAMIC_BUFFERED,
-                              telescope_stack_buffered<ctz_type>,
-                              typename std::conditional<strategy == NAIVE,
-                                                        naive_stack<uint64_t>,
-                                                        void>::type>::type>::
-    type;
+    typename std::conditional<
+        strategy == DYNAMIC_BUFFERED,
+        telescope_stack_buffered<ctz_type, index_type>,
+        typename std::conditional<strategy == NAIVE,
+                                  naive_stack<index_type>,
+                                  void>::type>::type>::type;
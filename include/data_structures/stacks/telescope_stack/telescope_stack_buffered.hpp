@@ -25,14 +25,14 @@
 #include <deque>
 #include <util/common.hpp>
 
-template <typename ctz_type>
+template <typename ctz_type, typename index_type = uint64_t>
 class telescope_stack_buffered {
 private:
   const uint64_t buffer_size_;
   const uint64_t half_buffer_size_;
 
-  telescope_stack_dynamic<ctz_type> tele_stack_;
-  std::deque<uint64_t> elements_;
+  telescope_stack_dynamic<ctz_type, index_type> tele_stack_;
+  std::deque<index_type> elements_;
 
   xssr_always_inline uint64_t get_max_size(const uint64_t n) {
     const uint64_t bytes = div<8>(n);
@@ -63,6 +63,14 @@ public:
     }
   }
 
+  // pushes value, value + distance, ..., value + (count - 1) * distance
+  xssr_always_inline void push_run(const uint64_t value,
+                                   const uint64_t distance,
+                                   const uint64_t count) {
+    for (uint64_t k = 0; k < count; ++k)
+      push(value + k * distance);
+  }
+
   xssr_always_inline void pop() {
     elements_.pop_back();
     if (xssr_unlikely(elements_.size() == 0)) {
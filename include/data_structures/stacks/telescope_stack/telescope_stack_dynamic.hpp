@@ -21,13 +21,15 @@
 #pragma once
 
 #include <data_structures/stacks/naive_stack/naive_stack.hpp>
+#include <limits>
 #include <util/common.hpp>
 
-template <typename ctz_type>
+template <typename ctz_type, typename index_type = uint64_t>
 class telescope_stack_dynamic {
 private:
   naive_stack<uint64_t> data_left_;
-  naive_stack<uint64_t> data_right_;
+  // jumps (pairs of value and bit position, both at most the largest value)
+  naive_stack<index_type> data_right_;
 
   uint64_t top_bit_;
   uint64_t top_bit_mod64_;
@@ -35,6 +37,35 @@ private:
 
   uint64_t top_word_;
 
+  // sets count ones, each distance bits after the previous one (starting at
+  // the top bit), and moves the top bit to the last of them
+  xssr_always_inline void append_periodic(const uint64_t distance,
+                                          uint64_t count) {
+    const uint64_t pattern = periodic_word(distance);
+    top_bit_ += count * distance;
+    while (count > 0) {
+      // ones that still fit into the top word
+      const uint64_t fit = std::min(count, (63 - top_bit_mod64_) / distance);
+      if (fit > 0) {
+        const uint64_t last = top_bit_mod64_ + fit * distance;
+        top_word_ |= (pattern >> (top_bit_mod64_ + distance)) &
+                     (word_all_one << (63 - last));
+        top_bit_mod64_ = last;
+        count -= fit;
+      }
+      if (count > 0) {
+        top_bit_mod64_ += distance;
+        while (top_bit_mod64_ > 63) {
+          top_bit_mod64_ -= 64;
+          data_left_.push(top_word_);
+          top_word_ = word_all_zero;
+        }
+        top_word_ |= word_left_one >> top_bit_mod64_;
+        --count;
+      }
+    }
+  }
+
 public:
   telescope_stack_dynamic()
       : top_bit_(0),
@@ -42,7 +73,7 @@ public:
         top_value_(0),
         top_word_(word_left_one) {
     // fill last word with 1s
-    data_right_.push(word_all_one);
+    data_right_.push(std::numeric_limits<index_type>::max());
   }
 
   telescope_stack_dynamic(const uint64_t) : telescope_stack_dynamic() {}
@@ -65,6 +96,22 @@ public:
     top_value_ = value;
   }
 
+  // pushes value, value + distance, ..., value + (count - 1) * distance
+  xssr_always_inline void push_run(const uint64_t value,
+                                   const uint64_t distance,
+                                   const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push(value);
+    if (distance > 127) {
+      for (uint64_t k = 1; k < count; ++k)
+        push(value + k * distance);
+    } else {
+      append_periodic(distance, count - 1);
+      top_value_ += (count - 1) * distance;
+    }
+  }
+
   xssr_always_inline uint64_t top() const {
     return top_value_;
   }
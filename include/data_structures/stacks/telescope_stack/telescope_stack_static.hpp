@@ -61,6 +61,23 @@ public:
     top_value_ = value;
   }
 
+  // pushes value, value + distance, ..., value + (count - 1) * distance
+  xssr_always_inline void push_run(const uint64_t value,
+                                   const uint64_t distance,
+                                   const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push(value);
+    if (distance > 127) {
+      for (uint64_t k = 1; k < count; ++k)
+        push(value + k * distance);
+    } else {
+      bv_.set_ones_periodic(top_bit_ + distance, distance, count - 1);
+      top_bit_ += (count - 1) * distance;
+      top_value_ += (count - 1) * distance;
+    }
+  }
+
   xssr_always_inline uint64_t top() const {
     return top_value_;
   }
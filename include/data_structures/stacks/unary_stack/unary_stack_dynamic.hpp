@@ -37,6 +37,35 @@ private:
 
   uint64_t top_word_;
 
+  // sets count ones, each distance bits after the previous one (starting at
+  // the top bit), and moves the top bit to the last of them
+  xssr_always_inline void append_periodic(const uint64_t distance,
+                                          uint64_t count) {
+    const uint64_t pattern = periodic_word(distance);
+    top_bit_ += count * distance;
+    while (count > 0) {
+      // ones that still fit into the top word
+      const uint64_t fit = std::min(count, (63 - top_bit_mod64_) / distance);
+      if (fit > 0) {
+        const uint64_t last = top_bit_mod64_ + fit * distance;
+        top_word_ |= (pattern >> (top_bit_mod64_ + distance)) &
+                     (word_all_one << (63 - last));
+        top_bit_mod64_ = last;
+        count -= fit;
+      }
+      if (count > 0) {
+        top_bit_mod64_ += distance;
+        while (top_bit_mod64_ > 63) {
+          top_bit_mod64_ -= 64;
+          data_left_.push(top_word_);
+          top_word_ = word_all_zero;
+        }
+        top_word_ |= word_left_one >> top_bit_mod64_;
+        --count;
+      }
+    }
+  }
+
 public:
   unary_stack_dynamic()
       : top_bit_(0),
@@ -66,6 +95,19 @@ public:
     top_value_ = value;
   }
 
+  // pushes value count times
+  xssr_always_inline void push_run(const uint64_t value, const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push(value);
+    if (value > 127) {
+      for (uint64_t k = 1; k < count; ++k)
+        push(value);
+    } else {
+      append_periodic(value, count - 1);
+    }
+  }
+
   xssr_always_inline uint64_t top() const {
     return top_value_;
   }
@@ -61,6 +61,20 @@ public:
     top_value_ = value;
   }
 
+  // pushes value count times
+  xssr_always_inline void push_run(const uint64_t value, const uint64_t count) {
+    if (xssr_unlikely(count == 0))
+      return;
+    push(value);
+    if (value > 127) {
+      for (uint64_t k = 1; k < count; ++k)
+        push(value);
+    } else {
+      bv_.set_ones_periodic(top_bit_ + value, value, count - 1);
+      top_bit_ += (count - 1) * value;
+    }
+  }
+
   xssr_always_inline uint64_t top() const {
     return top_value_;
   }
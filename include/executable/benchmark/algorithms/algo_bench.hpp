@@ -20,34 +20,49 @@
 
 #pragma once
 
+#include <algorithms/duval.hpp>
 #include <algorithms/psv_simple.hpp>
+#include <algorithms/xss_local.hpp>
 #include <algorithms/xss_bps.hpp>
 #include <algorithms/xss_bps_lcp.hpp>
 #include <algorithms/xss_herlez.hpp>
 #include <algorithms/xss_isa_psv.hpp>
 #include <algorithms/xss_real.hpp>
+#include <algorithms/xss_real_auto.hpp>
+#include <algorithms/xss_real_inplace.hpp>
+#include <algorithms/xss_real_nss.hpp>
+#include <algorithms/xss_real_online.hpp>
+#include <algorithms/xss_real_profile.hpp>
+#include <algorithms/xss_runs.hpp>
 #include <data_structures/bit_vectors/support/bps_support_sdsl.hpp>
+#include <data_structures/lce/lce_herlez1k.hpp>
+#include <data_structures/lce/lce_hybrid.hpp>
+#include <data_structures/lce/lce_naive.hpp>
 #include <data_structures/lce/lce_prezza.hpp>
 #include <data_structures/lce/lce_prezza1k.hpp>
 #include <data_structures/lce/lce_stats.hpp>
 #include <divsufsort.h>
 #include <gsaca.h>
+#include <memory>
 #include <nss-real.hpp>
 #include <sdsl/algorithms.hpp>
 #include <util/enums.hpp>
+#include <util/integer_types.hpp>
 
-enum output_types { array64, array32, bps };
+enum output_types { array64, array40, array32, bps };
 
 template <output_types type, typename runner_type, typename teardown_type>
-void run_generic(const std::string name,
-                 const std::string additional_info,
-                 runner_type& runner,
-                 teardown_type& teardown,
-                 const uint64_t n,
-                 const uint64_t runs,
-                 const uint64_t bpn_offset = 0) {
+uint64_t run_generic(const std::string name,
+                     const std::string additional_info,
+                     runner_type& runner,
+                     teardown_type& teardown,
+                     const uint64_t n,
+                     const uint64_t runs,
+                     const uint64_t bpn_offset = 0,
+                     const uint64_t bytes_per_char = 1) {
 
   static_assert(type == output_types::array32 ||
+                type == output_types::array40 ||
                 type == output_types::array64 || type == output_types::bps);
 
   std::cout << "RESULT algo=" << name << " ";
@@ -60,9 +75,12 @@ void run_generic(const std::string name,
 
   const uint64_t result_bytes =
       (type != output_types::bps)
-          ? ((type != output_types::array32) ? (8 * n) : (4 * n))
+          ? ((type == output_types::array32)
+                 ? (4 * n)
+                 : ((type == output_types::array40) ? (5 * n) : (8 * n)))
           : (n / 4);
-  const uint64_t total_memory = time_mem.second + n - (bpn_offset * n / 8);
+  const uint64_t total_memory =
+      time_mem.second + bytes_per_char * n - (bpn_offset * n / 8);
   const int64_t additional_memory =
       time_mem.second - result_bytes - (bpn_offset * n / 8);
 
@@ -77,17 +95,20 @@ void run_generic(const std::string name,
   std::cout << "mibs=" << mibs << " bpn=" << bpn
             << " additional_bpn=" << additional_bpn
             << " output_bytes=" << result_bytes << std::endl;
+  return time_mem.first;
 }
 
 template <output_types type, typename runner_type>
-void run_generic(const std::string name,
-                 const std::string additional_info,
-                 runner_type& runner,
-                 const uint64_t n,
-                 const uint64_t runs,
-                 const uint64_t bpn_offset = 0) {
+uint64_t run_generic(const std::string name,
+                     const std::string additional_info,
+                     runner_type& runner,
+                     const uint64_t n,
+                     const uint64_t runs,
+                     const uint64_t bpn_offset = 0,
+                     const uint64_t bytes_per_char = 1) {
   const auto dummy = []() {};
-  run_generic<type>(name, additional_info, runner, dummy, n, runs, bpn_offset);
+  return run_generic<type>(name, additional_info, runner, dummy, n, runs,
+                           bpn_offset, bytes_per_char);
 }
 
 template <typename get_compare_type, typename char_t>
@@ -114,7 +135,7 @@ void run_sdsl_generic(const get_compare_type get_compare,
 
   run_generic<output_types::array32>("sdsl-lyn-" + sdsl_info, additional_info,
                                      func, post, vector.size() - 2, runs,
-                                     bpn_offset);
+                                     bpn_offset, sizeof(char_t));
 }
 
 template <typename char_t>
@@ -144,7 +165,8 @@ void run_sdsl_prezza(const std::vector<char_t>& vector,
   const auto get_compare = [](char_t* text, const uint64_t n) {
     return lce_prezza<char_t>::get_suffix_compare(text, n);
   };
-  run_sdsl_generic(get_compare, vector, runs, additional_info, "prezza", 8);
+  run_sdsl_generic(get_compare, vector, runs, additional_info, "prezza",
+                   8 * sizeof(char_t));
 }
 
 template <typename char_t>
@@ -347,21 +369,442 @@ void run_divsufsort(const std::vector<char_t>& vector,
                                      vector.size() - 2, runs);
 }
 
-template <stack_strategy alloc, typename ctz_type, typename char_t>
+template <stack_strategy alloc,
+          typename ctz_type,
+          template <typename> class lce_type = lce_naive,
+          typename char_t>
 void run_xss_real(const std::vector<char_t>& vector,
+                  const uint64_t delta,
+                  const uint64_t runs,
+                  const std::string additional_info,
+                  const bool with_stats = false) {
+  const auto func = [&]() {
+    xss_real<alloc, ctz_type, lce_type>::run(vector.data(), vector.size(),
+                                             delta);
+  };
+  std::string info =
+      "ctz_strategy=" + ctz_type::to_string() +
+      " lce_type=" + lce_type<char_t>::to_string() +
+      " stack_type=" + std::to_string(alloc) +
+      ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+      ((additional_info.size() > 0) ? " " : "") + additional_info;
+  // the counters come from an extra (untimed) run
+  if (with_stats) {
+    xss_real<alloc, ctz_type, lce_type, xss_stats>::run(vector.data(),
+                                                        vector.size(), delta);
+    info += " " + xss_stats::local().to_string();
+  }
+  run_generic<output_types::bps>("xss-real", info, func, vector.size() - 2,
+                                 runs, 0, sizeof(char_t));
+}
+
+// packed copy of the text with bits bits per character (the packing is not
+// timed; texts with too many different characters are skipped)
+template <stack_strategy alloc,
+          typename ctz_type,
+          uint64_t bits,
+          typename char_t>
+void run_xss_real_packed(const std::vector<char_t>& vector,
+                         const uint64_t delta,
+                         const uint64_t runs,
+                         const std::string additional_info) {
+  std::unique_ptr<packed_text<bits>> text;
+  try {
+    text = std::make_unique<packed_text<bits>>(vector.data(), vector.size());
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    return;
+  }
+  const auto func = [&]() {
+    xss_real<alloc, ctz_type>::run_packed(*text, delta);
+  };
+  run_generic<output_types::bps>(
+      "xss-real-packed",
+      "ctz_strategy=" + ctz_type::to_string() +
+          " stack_type=" + std::to_string(alloc) +
+          ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+          " bits=" + std::to_string(bits) +
+          " text_bytes=" + std::to_string(text->bytes()) +
+          ((additional_info.size() > 0) ? " " : "") + additional_info,
+      func, vector.size() - 2, runs, 0, sizeof(char_t));
+}
+
+// the text is overwritten by the fingerprints and then by the bps, hence every
+// run works on a fresh copy of the text (restoring the copy is not timed)
+template <stack_strategy alloc, typename ctz_type, typename char_t>
+void run_xss_real_inplace(const std::vector<char_t>& vector,
+                          const uint64_t delta,
+                          const uint64_t runs,
+                          const std::string additional_info) {
+  using algo = xss_real_inplace<alloc, ctz_type>;
+  const uint64_t n = vector.size();
+  std::vector<char_t> buffer(algo::template buffer_bytes<char_t>(n) /
+                             sizeof(char_t));
+  std::copy(vector.begin(), vector.end(), buffer.begin());
+  const auto func = [&]() {
+    algo::run(buffer.data(), n, delta);
+  };
+  const auto post = [&]() {
+    std::copy(vector.begin(), vector.end(), buffer.begin());
+  };
+  run_generic<output_types::bps>(
+      "xss-real-inplace",
+      "ctz_strategy=" + ctz_type::to_string() +
+          " stack_type=" + std::to_string(alloc) +
+          ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+          ((additional_info.size() > 0) ? " " : "") + additional_info,
+      func, post, n - 2, runs, 0, sizeof(char_t));
+}
+
+// software prefetching with the given distance (0 disables prefetching)
+template <stack_strategy alloc,
+          typename ctz_type,
+          uint64_t prefetch_distance,
+          typename char_t>
+void run_xss_real_prefetch(const std::vector<char_t>& vector,
+                           const uint64_t delta,
+                           const uint64_t runs,
+                           const std::string additional_info) {
+  const auto func = [&]() {
+    xss_real<alloc, ctz_type, lce_naive, xss_no_stats, 128,
+             prefetch_distance>::run(vector.data(), vector.size(), delta);
+  };
+  run_generic<output_types::bps>(
+      "xss-real-prefetch",
+      "ctz_strategy=" + ctz_type::to_string() +
+          " stack_type=" + std::to_string(alloc) +
+          ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+          " prefetch_distance=" + std::to_string(prefetch_distance) +
+          ((additional_info.size() > 0) ? " " : "") + additional_info,
+      func, vector.size() - 2, runs, 0, sizeof(char_t));
+}
+
+// lyndon factorization (children of node 0 of the pss tree), decoded while
+// the bps is streamed
+template <stack_strategy alloc, typename ctz_type, typename char_t>
+void run_xss_real_lyndon(const std::vector<char_t>& vector,
+                         const uint64_t delta,
+                         const uint64_t runs,
+                         const std::string additional_info) {
+  uint64_t factors = 0;
+  const auto func = [&]() {
+    factors = 0;
+    xss_real<alloc, ctz_type>::run_lyndon_factorization(
+        vector.data(), vector.size(), [&](const uint64_t) { ++factors; },
+        delta);
+  };
+  run_generic<output_types::bps>(
+      "xss-real-lyndon",
+      "ctz_strategy=" + ctz_type::to_string() +
+          " stack_type=" + std::to_string(alloc) +
+          ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+          ((additional_info.size() > 0) ? " " : "") + additional_info,
+      func, vector.size() - 2, runs, 0, sizeof(char_t));
+  std::cout << "Number of lyndon factors: " << factors << std::endl;
+}
+
+// all runs (maximal repetitions), from the nss arrays of both orders
+template <stack_strategy alloc, typename ctz_type, typename char_t>
+void run_xss_runs(const std::vector<char_t>& vector,
                   const uint64_t delta,
                   const uint64_t runs,
                   const std::string additional_info) {
+  uint64_t count = 0;
+  const auto func = [&]() {
+    count = xss_runs<alloc, ctz_type>::run(vector.data(), vector.size(), delta)
+                .size();
+  };
+  run_generic<output_types::bps>(
+      "xss-runs",
+      "ctz_strategy=" + ctz_type::to_string() +
+          " stack_type=" + std::to_string(alloc) +
+          ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+          ((additional_info.size() > 0) ? " " : "") + additional_info,
+      func, vector.size() - 2, runs, 0, sizeof(char_t));
+  std::cout << "Number of runs: " << count << std::endl;
+}
+
+template <typename char_t>
+void run_duval_lyndon(const std::vector<char_t>& vector,
+                      const uint64_t runs,
+                      const std::string additional_info) {
+  uint64_t factors = 0;
+  const auto func = [&]() {
+    factors = 0;
+    lyndon_factorization(vector.data() + 1, vector.size() - 2,
+                         [&](const uint64_t) { ++factors; });
+  };
+  run_generic<output_types::bps>("duval-lyndon", additional_info, func,
+                                 vector.size() - 2, runs, 0, sizeof(char_t));
+  std::cout << "Number of lyndon factors: " << factors << std::endl;
+}
+
+// lyndon arrays of 16 windows of the text: from the bps and lce of the whole
+// text (xss-local-lyndon), and with xss_real on a copy of each window
+// (xss-real-window)
+template <typename char_t>
+void run_xss_local_lyndon(const std::vector<char_t>& vector,
+                          const uint64_t window,
+                          const uint64_t runs,
+                          const std::string additional_info) {
+  constexpr uint64_t windows = 16;
+  const uint64_t n = vector.size();
+  const uint64_t w = std::min(window, n - 2);
+  std::vector<uint64_t> starts(windows);
+  for (uint64_t k = 0; k < windows; ++k)
+    starts[k] = 1 + k * (n - 2 - w) / (windows - 1);
+
+  const auto bps = xss_real<>::run(vector.data(), n);
+  const bps_support_sdsl<bit_vector> support(bps);
+  auto lce = lce_naive<char_t>::get_lce(vector.data(), n);
+  const xss_local_lyndon<char_t, decltype(lce)> local(vector.data(), lce,
+                                                      support);
+
+  const std::string info = "window=" + std::to_string(w) +
+                           " windows=" + std::to_string(windows) +
+                           ((additional_info.size() > 0) ? " " : "") +
+                           additional_info;
+  const auto func_local = [&]() {
+    for (const auto l : starts)
+      local.lyndon(l, l + w);
+  };
+  run_generic<output_types::array32>("xss-local-lyndon", info, func_local,
+                                     windows * w, runs, 0, sizeof(char_t));
+
+  const auto func_copy = [&]() {
+    std::vector<char_t> copy(w + 2);
+    for (const auto l : starts) {
+      std::copy(vector.begin() + l, vector.begin() + l + w, copy.begin() + 1);
+      copy[0] = copy[w + 1] = 0;
+      xss_real<>::run_lyndon_array(copy.data(), copy.size());
+    }
+  };
+  run_generic<output_types::array32>("xss-real-window", info, func_copy,
+                                     windows * w, runs, 0, sizeof(char_t));
+}
+
+// the text grows by chunks of chunk characters, and the pss tree is extended
+// after each chunk (xss-real-online), versus recomputing the pss tree of the
+// grown text after each chunk (xss-real-recompute, only for at most 64
+// chunks)
+template <typename char_t>
+void run_xss_real_online(const std::vector<char_t>& vector,
+                         const uint64_t chunk,
+                         const uint64_t runs,
+                         const std::string additional_info) {
+  const uint64_t n = vector.size();
+  const uint64_t c = std::max(std::min(chunk, n - 2), (uint64_t) 1);
+  const std::string info = "chunk=" + std::to_string(c) +
+                           ((additional_info.size() > 0) ? " " : "") +
+                           additional_info;
+  uint64_t frontier = 0;
+  const auto func_online = [&]() {
+    const std::vector<char_t> empty = {vector.front(), vector.back()};
+    xss_real_online<char_t> online(empty.data(), empty.size());
+    for (uint64_t i = 1; i < n - 1; i += c)
+      online.append(vector.data() + i, std::min(c, n - 1 - i));
+    frontier = online.frontier();
+  };
+  run_generic<output_types::bps>("xss-real-online", info, func_online, n - 2,
+                                 runs, 0, sizeof(char_t));
+  std::cout << "Final positions: " << frontier << std::endl;
+
+  if ((n - 2) / c > 64)
+    return;
+  const auto func_recompute = [&]() {
+    std::vector<char_t> prefix = {vector.front()};
+    for (uint64_t i = 1; i < n - 1; i += c) {
+      prefix.insert(prefix.end(), vector.begin() + i,
+                    vector.begin() + std::min(i + c, n - 1));
+      prefix.push_back(vector.back());
+      xss_real<>::run(prefix.data(), prefix.size());
+      prefix.pop_back();
+    }
+  };
+  run_generic<output_types::bps>("xss-real-recompute", info, func_recompute,
+                                 n - 2, runs, 0, sizeof(char_t));
+}
+
+// strategy and delta are chosen for the memory budget (if the bps does not
+// fit, it is written to a temporary file)
+template <typename ctz_type, typename char_t>
+void run_xss_real_auto(const std::vector<char_t>& vector,
+                       const uint64_t memory_budget,
+                       const uint64_t runs,
+                       const std::string additional_info) {
+  using auto_type = xss_real_auto<ctz_type>;
+  const std::string path = "xss-real-auto.bps";
+  xss_auto_config config;
+  try {
+    config = auto_type::choose(vector.size(), memory_budget, true);
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << std::endl;
+    return;
+  }
   const auto func = [&]() {
-    xss_real<alloc, ctz_type>::run(vector.data(), vector.size(), delta);
+    auto_type::run_config(vector.data(), vector.size(), config, path);
+  };
+  const std::string info =
+      "ctz_strategy=" + ctz_type::to_string() +
+      " memory_budget=" + std::to_string(memory_budget) + " " +
+      config.to_string() + ((additional_info.size() > 0) ? " " : "") +
+      additional_info;
+  run_generic<output_types::bps>("xss-real-auto", info, func,
+                                 vector.size() - 2, runs, 0, sizeof(char_t));
+  std::remove(path.c_str());
+}
+
+// strategy, ctz type, delta and active threshold are given by the profile
+template <typename char_t>
+uint64_t run_xss_real_tuned(const std::vector<char_t>& vector,
+                            const xss_real_profile& profile,
+                            const uint64_t runs,
+                            const std::string additional_info) {
+  const auto func = [&]() {
+    xss_real_tuned<>::run(vector.data(), vector.size(), profile);
+  };
+  const std::string info = profile.to_string() +
+                           ((additional_info.size() > 0) ? " " : "") +
+                           additional_info;
+  return run_generic<output_types::bps>("xss-real-tuned", info, func,
+                                        vector.size() - 2, runs, 0,
+                                        sizeof(char_t));
+}
+
+// times every candidate profile on the sample and returns the fastest one
+template <typename char_t>
+xss_real_profile autotune_xss_real(const std::vector<char_t>& sample,
+                                   const uint64_t runs,
+                                   const std::string additional_info) {
+  xss_real_profile best;
+  uint64_t best_time = std::numeric_limits<uint64_t>::max();
+  for (const auto& profile : xss_real_profile::candidates()) {
+    const uint64_t time =
+        run_xss_real_tuned(sample, profile, runs, additional_info);
+    if (time < best_time) {
+      best = profile;
+      best_time = time;
+    }
+  }
+  return best;
+}
+
+// fixed type of the indices and lcps on the stack (instead of uint32_t for
+// texts shorter than 2^32)
+template <stack_strategy alloc,
+          typename ctz_type,
+          typename index_type,
+          typename char_t>
+void run_xss_real_indexed(const std::vector<char_t>& vector,
+                          const uint64_t delta,
+                          const uint64_t runs,
+                          const std::string additional_info) {
+  const auto func = [&]() {
+    xss_real<alloc, ctz_type>::template run_indexed<index_type>(
+        vector.data(), vector.size(), delta);
   };
   const std::string info =
       "ctz_strategy=" + ctz_type::to_string() +
       " stack_type=" + std::to_string(alloc) +
       ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+      " index_bits=" + std::to_string(8 * sizeof(index_type)) +
       ((additional_info.size() > 0) ? " " : "") + additional_info;
-  run_generic<output_types::bps>("xss-real", info, func, vector.size() - 2,
-                                 runs);
+  run_generic<output_types::bps>("xss-real-indexed", info, func,
+                                 vector.size() - 2, runs, 0, sizeof(char_t));
+}
+
+template <stack_strategy alloc,
+          typename ctz_type,
+          typename index_type,
+          typename char_t>
+void run_xss_real_with_nss(const std::vector<char_t>& vector,
+                           const uint64_t delta,
+                           const uint64_t runs,
+                           const std::string additional_info) {
+  constexpr output_types type = (sizeof(index_type) == 4)
+                                    ? output_types::array32
+                                    : output_types::array40;
+  const auto func = [&]() {
+    xss_real<alloc, ctz_type>::template run_with_nss<index_type>(
+        vector.data(), vector.size(), delta);
+  };
+  const std::string info =
+      "ctz_strategy=" + ctz_type::to_string() +
+      " stack_type=" + std::to_string(alloc) +
+      ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+      ((additional_info.size() > 0) ? " " : "") + additional_info;
+  run_generic<type>("xss-real-with-nss", info, func, vector.size() - 2, runs,
+                    0, sizeof(char_t));
+}
+
+template <stack_strategy alloc,
+          typename ctz_type,
+          typename index_type,
+          typename char_t>
+void run_xss_real_arrays(const std::vector<char_t>& vector,
+                         const uint64_t delta,
+                         const uint64_t runs,
+                         const std::string additional_info) {
+  using algo = xss_real<alloc, ctz_type>;
+  constexpr output_types type = (sizeof(index_type) == 4)
+                                    ? output_types::array32
+                                    : output_types::array40;
+  const std::string info =
+      "ctz_strategy=" + ctz_type::to_string() +
+      " stack_type=" + std::to_string(alloc) +
+      ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+      ((additional_info.size() > 0) ? " " : "") + additional_info;
+
+  const auto pss = [&]() {
+    algo::template run_pss_array<index_type>(vector.data(), vector.size(),
+                                             delta);
+  };
+  run_generic<type>("xss-real-pss-array", info, pss, vector.size() - 2, runs,
+                    0, sizeof(char_t));
+  const auto nss = [&]() {
+    algo::template run_nss_array<index_type>(vector.data(), vector.size(),
+                                             delta);
+  };
+  run_generic<type>("xss-real-nss-array", info, nss, vector.size() - 2, runs,
+                    0, sizeof(char_t));
+  const auto lyndon = [&]() {
+    algo::template run_lyndon_array<index_type>(vector.data(),
+                                                vector.size(), delta);
+  };
+  run_generic<type>("xss-real-lyndon-array", info, lyndon, vector.size() - 2,
+                    runs, 0, sizeof(char_t));
+}
+
+template <stack_strategy alloc, typename ctz_type, typename char_t>
+void run_xss_real_parallel(const std::vector<char_t>& vector,
+                           const uint64_t delta,
+                           const uint64_t max_threads,
+                           const uint64_t runs,
+                           const std::string additional_info) {
+  uint64_t single_thread_time = 0;
+  for (uint64_t threads = 1;; threads = std::min(threads << 1, max_threads)) {
+    const auto func = [&]() {
+      xss_real<alloc, ctz_type>::run_parallel(vector.data(), vector.size(),
+                                              delta, threads);
+    };
+    const std::string info =
+        "ctz_strategy=" + ctz_type::to_string() +
+        " stack_type=" + std::to_string(alloc) +
+        ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+        " threads=" + std::to_string(threads) +
+        ((additional_info.size() > 0) ? " " : "") + additional_info;
+    const uint64_t time = run_generic<output_types::bps>(
+        "xss-real-parallel", info, func, vector.size() - 2, runs, 0,
+        sizeof(char_t));
+    if (threads == 1) {
+      single_thread_time = time;
+    }
+    std::cout << "RESULT algo=xss-real-parallel-speedup " << info
+              << " speedup=" << (single_thread_time / (double) time)
+              << std::endl;
+    if (threads >= max_threads)
+      break;
+  }
 }
 
 template <typename char_t>
@@ -446,21 +889,48 @@ void run_lyndon2_real(const std::vector<char_t>& vector,
                                      vector.size() - 2, runs);
 }
 
-template <stack_strategy alloc, typename ctz_type, typename char_t>
+template <stack_strategy alloc,
+          typename ctz_type,
+          template <typename> class lce_type = lce_naive,
+          typename char_t>
 void run_xss_bps_lcp(const std::vector<char_t>& vector,
                      const uint64_t delta,
                      const uint64_t runs,
                      const std::string additional_info) {
   const auto func = [&]() {
-    xss_bps_lcp<alloc, ctz_type>::run(vector.data(), vector.size(), delta);
+    xss_bps_lcp<alloc, ctz_type, lce_type>::run(vector.data(), vector.size(),
+                                                delta);
   };
   const std::string info =
       "ctz_strategy=" + ctz_type::to_string() +
+      " lce_type=" + lce_type<char_t>::to_string() +
       " stack_type=" + std::to_string(alloc) +
       ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
       ((additional_info.size() > 0) ? " " : "") + additional_info;
   run_generic<output_types::bps>("xss-bps-lcp", info, func, vector.size() - 2,
-                                 runs);
+                                 runs, 0, sizeof(char_t));
+}
+
+template <stack_strategy alloc,
+          typename ctz_type,
+          template <typename> class lce_type = lce_naive,
+          typename char_t>
+void run_xss_real_nss(const std::vector<char_t>& vector,
+                      const uint64_t delta,
+                      const uint64_t runs,
+                      const std::string additional_info) {
+  const auto func = [&]() {
+    xss_real_nss<alloc, ctz_type, lce_type>::run(vector.data(), vector.size(),
+                                                 delta);
+  };
+  const std::string info =
+      "ctz_strategy=" + ctz_type::to_string() +
+      " lce_type=" + lce_type<char_t>::to_string() +
+      " stack_type=" + std::to_string(alloc) +
+      ((alloc != NAIVE) ? (" delta=" + std::to_string(delta)) : "") +
+      ((additional_info.size() > 0) ? " " : "") + additional_info;
+  run_generic<output_types::bps>("xss-real-nss", info, func, vector.size() - 2,
+                                 runs, 0, sizeof(char_t));
 }
 
 template <stack_strategy alloc, typename ctz_type, typename char_t>
@@ -475,7 +945,7 @@ void run_xss_bps(const std::vector<char_t>& vector,
                            ((additional_info.size() > 0) ? " " : "") +
                            additional_info;
   run_generic<output_types::bps>("xss-bps", info, func, vector.size() - 2,
-                                 runs);
+                                 runs, 0, sizeof(char_t));
 }
 
 template <typename char_t>
@@ -512,7 +982,7 @@ void run_rk1k_distribution(const std::vector<char_t>& vector,
   std::cout << "RESULT algo=lce_distribution " << additional_info << " "
             << std::flush;
 
-  auto rk = lce_stats<>::get_suffix_compare(vector.data(), vector.size());
+  auto rk = lce_stats<char_t>::get_suffix_compare(vector.data(), vector.size());
   psv_simple<>::run_from_comparison(rk, vector.size());
 
   auto& distr = rk.lce_distribution_;
@@ -544,13 +1014,15 @@ void run_rk1k_distribution(const std::vector<char_t>& vector,
   }
   std::cout << "(1, " << max << ") " << std::flush;
 
-  xss_real<NAIVE>::run<true>(vector.data(), vector.size(), 0);
-  std::cout << "skipped_by_re=" << xss_real_stats.skipped_re << " ";
-  std::cout << "skipped_by_al=" << xss_real_stats.skipped_al << " ";
+  xss_real<NAIVE, ctz_builtin, lce_naive, xss_stats>::run(vector.data(),
+                                                          vector.size(), 0);
+  const auto& stats = xss_stats::local();
+  std::cout << "skipped_by_re=" << stats.skipped_re << " ";
+  std::cout << "skipped_by_al=" << stats.skipped_al << " ";
   std::cout << "skipped_by_re_percent="
-            << xss_real_stats.skipped_re / ((double) vector.size()) << " ";
+            << stats.skipped_re / ((double) vector.size()) << " ";
   std::cout << "skipped_by_al_percent="
-            << xss_real_stats.skipped_al / ((double) vector.size())
+            << stats.skipped_al / ((double) vector.size())
             << std::endl;
 }
 
@@ -580,5 +1052,5 @@ void run_bps_support_sdsl(const std::vector<char_t>& vector,
   const auto func = [&]() { volatile bps_support_sdsl build(bps); };
 
   run_generic<output_types::bps>("bps-support-sada", additional_info, func,
-                                 vector.size() - 2, runs);
+                                 vector.size() - 2, runs, 0, sizeof(char_t));
 }
\ No newline at end of file
@@ -75,4 +75,42 @@ constexpr xssr_always_inline static uint64_t mul8(const uint64_t value) {
 
 constexpr xssr_always_inline static uint64_t mod64(const uint64_t value) {
   return mod<64>(value);
-}
\ No newline at end of file
+}
+
+// word with a one at every distance-th bit, starting with the leftmost bit
+constexpr xssr_always_inline static uint64_t
+periodic_word(const uint64_t distance) {
+  uint64_t result = word_left_one;
+  for (uint64_t shift = distance; shift < 64; shift <<= 1)
+    result |= result >> shift;
+  return result;
+}
+
+// the algorithms access texts of value_type via text_pointer_t<value_type>,
+// which is a plain pointer except for packed texts (see packed_text.hpp);
+// text_value_t maps the pointer type back to value_type
+template <typename value_type>
+struct text_pointer {
+  using type = const value_type*;
+};
+
+template <typename value_type>
+using text_pointer_t = typename text_pointer<value_type>::type;
+
+template <typename text_type>
+struct text_value {
+  using type = typename text_type::value_type;
+};
+
+template <typename value_type>
+struct text_value<const value_type*> {
+  using type = value_type;
+};
+
+template <typename value_type>
+struct text_value<value_type*> {
+  using type = value_type;
+};
+
+template <typename text_type>
+using text_value_t = typename text_value<text_type>::type;
@@ -70,20 +70,29 @@ static void standardize(std::vector<char_t>& vector) {
   constexpr char_t min_val = std::numeric_limits<char_t>::min();
   constexpr char_t max_val = std::numeric_limits<char_t>::max();
 
-  std::vector<bool> count_sigma(1ULL << (sizeof(char_t) * 8), false);
-
   char_t min_current = max_val;
   char_t max_current = min_val;
   for (uint64_t i = 1; i < vector.size() - 1; ++i) {
     const auto character = vector[i];
     min_current = std::min(min_current, character);
     max_current = std::max(max_current, character);
-    count_sigma[character] = true;
   }
 
   uint64_t sigma = 0;
-  for (const auto b : count_sigma) {
-    sigma += b ? 1 : 0;
+  if constexpr (sizeof(char_t) <= 2) {
+    std::vector<bool> count_sigma(1ULL << (sizeof(char_t) * 8), false);
+    for (uint64_t i = 1; i < vector.size() - 1; ++i) {
+      count_sigma[vector[i]] = true;
+    }
+    for (const auto b : count_sigma) {
+      sigma += b ? 1 : 0;
+    }
+  } else {
+    // integer alphabet: count the distinct characters of a sorted copy
+    std::vector<char_t> characters(vector.begin() + 1, vector.end() - 1);
+    std::sort(characters.begin(), characters.end());
+    sigma = std::unique(characters.begin(), characters.end()) -
+            characters.begin();
   }
   std::cout << "[STANDARDIZE]         Alphabet size: sigma=" << sigma << "."
             << std::endl;
@@ -119,7 +128,7 @@ static void standardize(std::vector<char_t>& vector) {
   vector[vector.size() - 1] = min_val;
 }
 
-// adds sentinels
+// adds sentinels (characters of sizeof(char_t) bytes in native byte order)
 template <typename char_t>
 static std::vector<char_t> file_to_instance(const std::string& file_name,
                                             const uint64_t prefix_size) {
@@ -153,4 +162,48 @@ static std::vector<char_t> file_to_instance(const std::string& file_name,
             << "[" << to_SI_string(size_in_bytes) << "]" << std::endl;
   standardize(result);
   return result;
-}
\ No newline at end of file
+}
+// concatenation of chunks (chunks_per_file many per file, evenly spread over
+// the file) with a total length of at most sample_size characters
+template <typename char_t>
+static std::vector<char_t>
+files_to_sample(const std::vector<std::string>& file_names,
+                const uint64_t sample_size,
+                const uint64_t chunks_per_file = 8) {
+  const uint64_t chunks = std::max(file_names.size() * chunks_per_file,
+                                   (uint64_t) 1);
+  const uint64_t chunk_size = std::max(sample_size / chunks, (uint64_t) 1);
+
+  // +2 sentinels
+  std::vector<char_t> result(1);
+  for (const auto& file_name : file_names) {
+    std::ifstream stream(file_name.c_str(), std::ios::in | std::ios::binary);
+    if (!stream) {
+      std::cerr << "File " << file_name << " not found.\n";
+      exit(EXIT_FAILURE);
+    }
+    stream.seekg(0, std::ios::end);
+    const uint64_t size_in_characters = stream.tellg() / sizeof(char_t);
+    const uint64_t length = std::min(chunk_size, size_in_characters);
+    const uint64_t stride =
+        (size_in_characters - length) / std::max(chunks_per_file - 1, (uint64_t) 1);
+    for (uint64_t k = 0; k < chunks_per_file; ++k) {
+      const uint64_t offset = result.size();
+      result.resize(offset + length);
+      stream.seekg(k * stride * sizeof(char_t));
+      stream.read(reinterpret_cast<char*>(&(result.data()[offset])),
+                  length * sizeof(char_t));
+      // (a file shorter than the chunk is only sampled once)
+      if (length == size_in_characters)
+        break;
+    }
+  }
+  result.push_back(0);
+
+  const uint64_t size_in_bytes = (result.size() - 2) * sizeof(char_t);
+  std::cout << "Sampled " << (result.size() - 2) << " characters ["
+            << to_SI_string(size_in_bytes) << "] from " << file_names.size()
+            << " file(s)." << std::endl;
+  standardize(result);
+  return result;
+}
@@ -70,4 +70,22 @@ static_assert(sizeof(uint_t<25>) == 4, "sanity check");
 static_assert(sizeof(uint_t<33>) == 8, "sanity check");
 static_assert(sizeof(uint_t<41>) == 8, "sanity check");
 static_assert(sizeof(uint_t<49>) == 8, "sanity check");
-static_assert(sizeof(uint_t<57>) == 8, "sanity check");
\ No newline at end of file
+static_assert(sizeof(uint_t<57>) == 8, "sanity check");
+// unsigned integer with 40 bits that occupies exactly 5 bytes
+// (e.g. for arrays of text positions if n >= 2^32)
+class uint40_t {
+private:
+  uint32_t low_;
+  uint8_t high_;
+
+public:
+  uint40_t() = default;
+
+  uint40_t(const uint64_t value) : low_(value), high_(value >> 32) {}
+
+  operator uint64_t() const {
+    return (((uint64_t) high_) << 32) | low_;
+  }
+} __attribute__((packed));
+
+static_assert(sizeof(uint40_t) == 5, "sanity check");
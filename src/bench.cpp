@@ -19,6 +19,7 @@
 //  IN THE SOFTWARE.
 
 #include <iostream>
+#include <omp.h>
 #include <tlx/cmdline_parser.hpp>
 
 #ifdef MALLOC_COUNT
@@ -38,14 +39,24 @@ struct {
   uint64_t ctz_strategy = 0;
   uint64_t delta = std::numeric_limits<uint64_t>::max();
   uint64_t quantiles = 0;
+  uint64_t threads = omp_get_max_threads();
+  uint64_t max_memory = 0;
+  uint64_t local_window = 0;
+  uint64_t append_chunk = 0;
 
   bool default_bench = false;
   bool ctz_bench = false;
   bool stack_bench = false;
+  bool width_bench = false;
   bool z_term = false;
+  bool stats = false;
 
   std::vector<uint64_t> deltas;
 
+  std::string autotune = "";
+  uint64_t autotune_sample = 8ULL << 20;
+  std::string profile = "";
+
   std::string contains = "";
   std::string not_contains = "";
 
@@ -77,7 +88,8 @@ template <typename ctz_type, typename char_t>
 int32_t run(const std::vector<char_t>& vector, const std::string name) {
   const auto& s = global_settings;
   const uint64_t runs = s.number_of_runs;
-  std::string additional_info = "file=" + name;
+  std::string additional_info =
+      "file=" + name + " bytes_per_char=" + std::to_string(sizeof(char_t));
 
   if (s.stack_bench) {
 
@@ -101,47 +113,161 @@ int32_t run(const std::vector<char_t>& vector, const std::string name) {
                                                additional_info);
     }
 
+    // 32 bit versus 64 bit indices and lcps on the stack
+    const bool fits_32 = vector.size() < (1ULL << 32);
+    if (fits_32) {
+      run_xss_real_indexed<NAIVE, ctz_type, uint32_t>(vector, 0, runs,
+                                                      additional_info);
+    }
+    run_xss_real_indexed<NAIVE, ctz_type, uint64_t>(vector, 0, runs,
+                                                    additional_info);
+    for (uint64_t delta = 1; delta <= 128; delta <<= 1) {
+      if (fits_32) {
+        run_xss_real_indexed<DYNAMIC_BUFFERED, ctz_type, uint32_t>(
+            vector, delta >> 1, runs, additional_info);
+      }
+      run_xss_real_indexed<DYNAMIC_BUFFERED, ctz_type, uint64_t>(
+          vector, delta >> 1, runs, additional_info);
+    }
+
   } else if (s.default_bench) {
 
     // linear time stuff goes first
     if (s.matches("xss-real")) {
       for (const auto delta : s.deltas) {
         run_xss_real<DYNAMIC_BUFFERED, ctz_type>(vector, delta, runs,
-                                                 additional_info);
-        run_xss_real<DYNAMIC, ctz_type>(vector, delta, runs, additional_info);
+                                                 additional_info, s.stats);
+        run_xss_real<DYNAMIC, ctz_type>(vector, delta, runs, additional_info,
+                                        s.stats);
+      }
+    }
+
+    // construction that overwrites the text buffer with the bps
+    if (s.matches("xss-real-inplace")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_inplace<DYNAMIC_BUFFERED, ctz_type>(vector, delta, runs,
+                                                         additional_info);
       }
     }
 
-    if (s.matches("nss-real") || s.matches("nss-real-array")) {
-      run_nss_real(vector, runs, additional_info);
+    // 2 bit and 4 bit packed texts (e.g. dna)
+    if (s.matches("xss-real-packed")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_packed<DYNAMIC_BUFFERED, ctz_type, 2>(vector, delta, runs,
+                                                           additional_info);
+        run_xss_real_packed<DYNAMIC_BUFFERED, ctz_type, 4>(vector, delta, runs,
+                                                           additional_info);
+      }
+    }
+
+    // software prefetching (best seen on texts far larger than the last
+    // level cache, e.g. with --length)
+    if (s.matches("xss-real-prefetch")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_prefetch<DYNAMIC_BUFFERED, ctz_type, 0>(
+            vector, delta, runs, additional_info);
+        run_xss_real_prefetch<DYNAMIC_BUFFERED, ctz_type, 64>(
+            vector, delta, runs, additional_info);
+        run_xss_real_prefetch<DYNAMIC_BUFFERED, ctz_type, 256>(
+            vector, delta, runs, additional_info);
+        run_xss_real_prefetch<DYNAMIC_BUFFERED, ctz_type, 1024>(
+            vector, delta, runs, additional_info);
+      }
+    }
+
+    // only the lyndon factorization, without keeping the bps
+    if (s.matches("xss-real-lyndon")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_lyndon<DYNAMIC_BUFFERED, ctz_type>(vector, delta, runs,
+                                                        additional_info);
+      }
+    }
+    if (s.matches("duval-lyndon")) {
+      run_duval_lyndon(vector, runs, additional_info);
+    }
+    if (s.matches("xss-runs")) {
+      for (const auto delta : s.deltas) {
+        run_xss_runs<DYNAMIC_BUFFERED, ctz_type>(vector, delta, runs,
+                                                 additional_info);
+      }
     }
 
-    if (s.matches("nss-real2") || s.matches("nss-real2-array")) {
-      run_nss2_real(vector, runs, additional_info);
+    if (s.local_window > 0 &&
+        (s.matches("xss-local-lyndon") || s.matches("xss-real-window"))) {
+      run_xss_local_lyndon(vector, s.local_window, runs, additional_info);
     }
 
-    if (s.matches("pss-real") || s.matches("pss-real-array")) {
-      run_pss_real(vector, runs, additional_info);
+    if (s.append_chunk > 0 && (s.matches("xss-real-online") ||
+                               s.matches("xss-real-recompute"))) {
+      run_xss_real_online(vector, s.append_chunk, runs, additional_info);
     }
 
-    if (s.matches("pss-real2") || s.matches("pss-real2-array")) {
-      run_pss2_real(vector, runs, additional_info);
+    if (s.profile.size() > 0 && s.matches("xss-real-tuned")) {
+      run_xss_real_tuned(vector, xss_real_profile::load(s.profile), runs,
+                         additional_info);
     }
 
-    if (s.matches("nss-pss-real") || s.matches("nss-pss-real-array")) {
-      run_nss_pss_real(vector, runs, additional_info);
+    if (s.max_memory > 0 && s.matches("xss-real-auto")) {
+      run_xss_real_auto<ctz_type>(vector, s.max_memory, runs,
+                                  additional_info);
     }
 
-    if (s.matches("nss-pss-real2") || s.matches("nss-pss-real2-array")) {
-      run_nss_pss2_real(vector, runs, additional_info);
+    // every lce backend that does not overwrite the text
+    if (s.matches("xss-real-lce")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real<DYNAMIC_BUFFERED, ctz_type, lce_naive>(
+            vector, delta, runs, additional_info, s.stats);
+        run_xss_real<DYNAMIC_BUFFERED, ctz_type, lce_prezza>(
+            vector, delta, runs, additional_info, s.stats);
+        run_xss_real<DYNAMIC_BUFFERED, ctz_type, lce_prezza1k>(
+            vector, delta, runs, additional_info, s.stats);
+        run_xss_real<DYNAMIC_BUFFERED, ctz_type, lce_herlez1k>(
+            vector, delta, runs, additional_info, s.stats);
+        run_xss_real<DYNAMIC_BUFFERED, ctz_type, lce_hybrid>(
+            vector, delta, runs, additional_info, s.stats);
+      }
     }
 
-    if (s.matches("lyndon-real") || s.matches("lyndon-real-array")) {
-      run_lyndon_real(vector, runs, additional_info);
+    if (s.matches("xss-real-parallel")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_parallel<DYNAMIC_BUFFERED, ctz_type>(
+            vector, delta, s.threads, runs, additional_info);
+      }
     }
 
-    if (s.matches("lyndon-real2") || s.matches("lyndon-real2-array")) {
-      run_lyndon2_real(vector, runs, additional_info);
+    // these algorithms only support byte alphabets
+    if constexpr (sizeof(char_t) == 1) {
+      if (s.matches("nss-real") || s.matches("nss-real-array")) {
+        run_nss_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("nss-real2") || s.matches("nss-real2-array")) {
+        run_nss2_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("pss-real") || s.matches("pss-real-array")) {
+        run_pss_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("pss-real2") || s.matches("pss-real2-array")) {
+        run_pss2_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("nss-pss-real") || s.matches("nss-pss-real-array")) {
+        run_nss_pss_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("nss-pss-real2") || s.matches("nss-pss-real2-array")) {
+        run_nss_pss2_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("lyndon-real") || s.matches("lyndon-real-array")) {
+        run_lyndon_real(vector, runs, additional_info);
+      }
+
+      if (s.matches("lyndon-real2") || s.matches("lyndon-real2-array")) {
+        run_lyndon2_real(vector, runs, additional_info);
+      }
     }
 
     if (s.matches("xss-bps-lcp")) {
@@ -153,6 +279,50 @@ int32_t run(const std::vector<char_t>& vector, const std::string name) {
       }
     }
 
+    if (s.matches("xss-bps-lcp-lce")) {
+      for (const auto delta : s.deltas) {
+        run_xss_bps_lcp<DYNAMIC_BUFFERED, ctz_type, lce_naive>(
+            vector, delta, runs, additional_info);
+        run_xss_bps_lcp<DYNAMIC_BUFFERED, ctz_type, lce_prezza>(
+            vector, delta, runs, additional_info);
+        run_xss_bps_lcp<DYNAMIC_BUFFERED, ctz_type, lce_prezza1k>(
+            vector, delta, runs, additional_info);
+        run_xss_bps_lcp<DYNAMIC_BUFFERED, ctz_type, lce_herlez1k>(
+            vector, delta, runs, additional_info);
+      }
+    }
+
+    if (s.matches("xss-real-with-nss")) {
+      for (const auto delta : s.deltas) {
+        if (!index_array::is_wide(vector.size()))
+          run_xss_real_with_nss<DYNAMIC_BUFFERED, ctz_type, uint32_t>(
+              vector, delta, runs, additional_info);
+        else
+          run_xss_real_with_nss<DYNAMIC_BUFFERED, ctz_type, uint40_t>(
+              vector, delta, runs, additional_info);
+      }
+    }
+
+    if (s.matches("xss-real-array")) {
+      for (const auto delta : s.deltas) {
+        if (!index_array::is_wide(vector.size()))
+          run_xss_real_arrays<DYNAMIC_BUFFERED, ctz_type, uint32_t>(
+              vector, delta, runs, additional_info);
+        else
+          run_xss_real_arrays<DYNAMIC_BUFFERED, ctz_type, uint40_t>(
+              vector, delta, runs, additional_info);
+      }
+    }
+
+    if (s.matches("xss-real-nss")) {
+      for (const auto delta : s.deltas) {
+        run_xss_real_nss<DYNAMIC_BUFFERED, ctz_type>(vector, delta, runs,
+                                                     additional_info);
+        run_xss_real_nss<DYNAMIC_BUFFERED, ctz_type, lce_prezza1k>(
+            vector, delta, runs, additional_info);
+      }
+    }
+
     if (s.matches("xss-bps")) {
       run_xss_bps<DYNAMIC_BUFFERED, ctz_type>(vector, runs, additional_info);
       run_xss_bps<DYNAMIC, ctz_type>(vector, runs, additional_info);
@@ -173,18 +343,21 @@ int32_t run(const std::vector<char_t>& vector, const std::string name) {
     if (s.matches("sdsl-lyn-prezza-1k"))
       run_sdsl_prezza1k(vector, runs, additional_info);
 
-    if (s.matches("sdsl-isa-nsv"))
-      run_sdsl_isa_nsv(vector, runs, additional_info);
+    // these algorithms only support byte alphabets
+    if constexpr (sizeof(char_t) == 1) {
+      if (s.matches("sdsl-isa-nsv"))
+        run_sdsl_isa_nsv(vector, runs, additional_info);
 
-    if (s.matches("divsufsort"))
-      run_divsufsort(vector, runs, additional_info);
+      if (s.matches("divsufsort"))
+        run_divsufsort(vector, runs, additional_info);
 
-    if (s.matches("gsaca"))
-      run_gsaca(vector, runs, additional_info);
-    if (s.matches("gsaca-phase1"))
-      run_gsaca_phase1(vector, runs, additional_info);
-    if (s.matches("gsaca-lyndon"))
-      run_gsaca_lyndon(vector, runs, additional_info);
+      if (s.matches("gsaca"))
+        run_gsaca(vector, runs, additional_info);
+      if (s.matches("gsaca-phase1"))
+        run_gsaca_phase1(vector, runs, additional_info);
+      if (s.matches("gsaca-lyndon"))
+        run_gsaca_lyndon(vector, runs, additional_info);
+    }
 
     //    if (s.matches("xss-isa-psv"))
     //      run_xss_isa_psv(vector, runs, additional_info);
@@ -210,8 +383,34 @@ int32_t run(const std::vector<char_t>& vector, const std::string name) {
   return 0;
 }
 
+template <typename wide_char_t, typename char_t>
+std::vector<wide_char_t> widen(const std::vector<char_t>& vector) {
+  return std::vector<wide_char_t>(vector.begin(), vector.end());
+}
+
+// samples the files, and writes the fastest configuration of xss_real on the
+// sample to the profile
+template <typename char_t>
+int32_t autotune() {
+  const auto& s = global_settings;
+  const std::vector<char_t> sample =
+      files_to_sample<char_t>(s.file_paths, s.autotune_sample);
+  const std::string additional_info =
+      "sample_size=" + std::to_string(sample.size() - 2) +
+      " bytes_per_char=" + std::to_string(sizeof(char_t));
+  const auto best =
+      autotune_xss_real(sample, s.number_of_runs, additional_info);
+  best.save(s.autotune);
+  std::cout << "Best configuration: " << best.to_string() << std::endl;
+  std::cout << "Saved profile: \"" << s.autotune << "\"." << std::endl;
+  return 0;
+}
+
 template <typename char_t>
 int32_t start() {
+  if (global_settings.autotune.size() > 0) {
+    return autotune<char_t>();
+  }
   if (global_settings.stack_bench && global_settings.file_paths.size() == 0) {
     //    if (global_settings.matches("lcp")) {
     for (uint64_t i = 2; i <= 1024; i <<= 1) {
@@ -230,7 +429,7 @@ int32_t start() {
     std::vector<char_t> text_vec =
         file_to_instance<char_t>(file, global_settings.prefix_size);
     if (global_settings.z_term && text_vec.size() > 2) {
-      text_vec[text_vec.size() - 2] = std::numeric_limits<uint8_t>::max();
+      text_vec[text_vec.size() - 2] = std::numeric_limits<char_t>::max();
     }
     std::cout << "Input ready." << std::endl;
 
@@ -244,7 +443,15 @@ int32_t start() {
                             global_settings.quantiles);
     }
 
-    run<ctz_builtin>(text_vec, file);
+    if (global_settings.width_bench) {
+      // same text (and same tree) with wider characters
+      run<ctz_builtin>(text_vec, file);
+      run<ctz_builtin>(widen<uint_bytes_t<2>>(text_vec), file);
+      run<ctz_builtin>(widen<uint_bytes_t<4>>(text_vec), file);
+      run<ctz_builtin>(widen<uint_bytes_t<8>>(text_vec), file);
+    } else {
+      run<ctz_builtin>(text_vec, file);
+    }
   }
   return 0;
 }
@@ -266,6 +473,31 @@ int32_t main(int32_t argc, char const* argv[]) {
                "Length of the prefix of the text that should be considered.");
   cp.add_bytes('\0', "delta", global_settings.delta,
                "Parameter delta of the LCP stack. (default = 0 and 4)");
+  cp.add_bytes('\0', "bytes-per-char", global_settings.bytes_per_char,
+               "Number of bytes per character of the input text: 1, 2, 4 or "
+               "8 (default = 1).");
+  cp.add_bytes('\0', "threads", global_settings.threads,
+               "Maximum number of threads for parallel algorithms "
+               "(default = all available threads).");
+
+  cp.add_bytes('\0', "max-memory", global_settings.max_memory,
+               "Memory budget of xss-real-auto, which chooses the stack "
+               "strategy and delta that fit into the budget (e.g. 2Gi).");
+
+  cp.add_bytes('\0', "local-window", global_settings.local_window,
+               "Window length of xss-local-lyndon, which computes the lyndon "
+               "arrays of windows of the text from the bps of the text.");
+  cp.add_bytes('\0', "append-chunk", global_settings.append_chunk,
+               "Chunk length of xss-real-online, which extends the pss tree "
+               "while the text grows by one chunk at a time.");
+  cp.add_string('\0', "autotune", global_settings.autotune,
+                "Time all configurations of xss-real (stack strategy, ctz "
+                "type, delta, active threshold) on a sample of the files, "
+                "and write the fastest one to the given profile.");
+  cp.add_bytes('\0', "autotune-sample", global_settings.autotune_sample,
+               "Size of the sample of the autotuner (default = 8Mi).");
+  cp.add_string('\0', "profile", global_settings.profile,
+                "Profile of xss-real-tuned (written by --autotune).");
 
   cp.add_flag('\0', "bench-default", global_settings.default_bench,
               "Execute the default benchmark.");
@@ -273,9 +505,15 @@ int32_t main(int32_t argc, char const* argv[]) {
               "Execute the benchmark for trailing / leading zeros.");
   cp.add_flag('\0', "bench-stacks", global_settings.stack_bench,
               "Execute the benchmark for stack implementations.");
+  cp.add_flag('\0', "bench-widths", global_settings.width_bench,
+              "Execute the default benchmark on copies of the text with 1, "
+              "2, 4 and 8 bytes per character.");
 
   cp.add_bytes('\0', "lce-stats", global_settings.quantiles,
                "Computes LCE statistics with given number of quantiles.");
+  cp.add_flag('\0', "stats", global_settings.stats,
+              "Append the counters of xss-real (pushes, pops, lce calls, "
+              "skipped indices, ...) to its results.");
 
   cp.add_flag('z', "z", global_settings.z_term,
               "Replace the last character by a maximal character.");
@@ -297,8 +535,44 @@ int32_t main(int32_t argc, char const* argv[]) {
     std::cout << "Algorithms:" << std::endl;
     std::cout << "    "
               << "xss-real" << std::endl;
+    std::cout << "    "
+              << "xss-real-lce" << std::endl;
+    std::cout << "    "
+              << "xss-real-parallel" << std::endl;
+    std::cout << "    "
+              << "xss-real-prefetch" << std::endl;
+    std::cout << "    "
+              << "xss-real-packed" << std::endl;
+    std::cout << "    "
+              << "xss-real-inplace" << std::endl;
+    std::cout << "    "
+              << "xss-real-auto (requires --max-memory)" << std::endl;
+    std::cout << "    "
+              << "xss-real-tuned (requires --profile)" << std::endl;
+    std::cout << "    "
+              << "xss-real-lyndon" << std::endl;
+    std::cout << "    "
+              << "duval-lyndon" << std::endl;
+    std::cout << "    "
+              << "xss-runs" << std::endl;
+    std::cout << "    "
+              << "xss-local-lyndon (requires --local-window)" << std::endl;
+    std::cout << "    "
+              << "xss-real-window (requires --local-window)" << std::endl;
+    std::cout << "    "
+              << "xss-real-online (requires --append-chunk)" << std::endl;
+    std::cout << "    "
+              << "xss-real-recompute (requires --append-chunk)" << std::endl;
     std::cout << "    "
               << "xss-bps-lcp" << std::endl;
+    std::cout << "    "
+              << "xss-bps-lcp-lce" << std::endl;
+    std::cout << "    "
+              << "xss-real-nss" << std::endl;
+    std::cout << "    "
+              << "xss-real-with-nss" << std::endl;
+    std::cout << "    "
+              << "xss-real-array" << std::endl;
     std::cout << "    "
               << "xss-bps" << std::endl;
     std::cout << "    "
@@ -353,5 +627,29 @@ int32_t main(int32_t argc, char const* argv[]) {
     return 0;
   }
 
-  return start<uint_bytes_t<1>>();
+  if (global_settings.autotune.size() > 0 &&
+      global_settings.file_paths.size() == 0) {
+    std::cerr << "--autotune requires at least one file." << std::endl;
+    return -1;
+  }
+
+  if (global_settings.width_bench && global_settings.bytes_per_char != 1) {
+    std::cerr << "--bench-widths requires --bytes-per-char 1." << std::endl;
+    return -1;
+  }
+
+  switch (global_settings.bytes_per_char) {
+  case 1:
+    return start<uint_bytes_t<1>>();
+  case 2:
+    return start<uint_bytes_t<2>>();
+  case 4:
+    return start<uint_bytes_t<4>>();
+  case 8:
+    return start<uint_bytes_t<8>>();
+  default:
+    std::cerr << "Number of bytes per character must be 1, 2, 4 or 8."
+              << std::endl;
+    return -1;
+  }
 }
\ No newline at end of file
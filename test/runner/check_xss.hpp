@@ -21,20 +21,434 @@
 #pragma once
 
 #include "util/enums.hpp"
+#include <algorithms/duval.hpp>
 #include <algorithms/xss_real.hpp>
+#include <algorithms/xss_real_auto.hpp>
+#include <algorithms/xss_real_inplace.hpp>
+#include <algorithms/xss_real_online.hpp>
+#include <algorithms/xss_runs.hpp>
 #include <algorithms/xss_bps.hpp>
 #include <algorithms/xss_bps_lcp.hpp>
 #include <algorithms/psv_simple.hpp>
 #include <algorithms/xss_herlez.hpp>
 #include <algorithms/xss_isa_psv.hpp>
+#include <algorithms/xss_local.hpp>
 #include <data_structures/stacks/stack_strategy.hpp>
+#include <data_structures/lce/lce_herlez1k.hpp>
+#include <data_structures/lce/lce_hybrid.hpp>
 #include <data_structures/lce/lce_prezza.hpp>
+#include <data_structures/lce/lce_prezza1k.hpp>
+#include <data_structures/bit_vectors/bps_stream.hpp>
+#include <data_structures/bit_vectors/support/bps_support_naive.hpp>
+
+// window of 8 words, such that the bps leaves the window frequently
+constexpr static uint64_t check_window_words = 8;
+
+template <stack_strategy strategy, typename vec_type>
+static bit_vector run_xss_real_to_callback(const vec_type &instance,
+                                           const uint64_t delta) {
+  bit_vector result(2 * instance.size() + 2, BV_FILL_ZERO);
+  uint64_t words = 0;
+  const auto callback = [&](const uint64_t *data, const uint64_t count) {
+    memcpy(result.data() + words, data, mul8(count));
+    words += count;
+  };
+  bps_callback_sink<decltype(callback)> sink(callback);
+  xss_real<strategy, ctz_builtin>::run_to_sink(
+      instance.data(), instance.size(), sink, delta, check_window_words);
+  return result;
+}
+
+template <stack_strategy strategy, typename vec_type>
+static bit_vector run_xss_real_to_file(const vec_type &instance,
+                                       const uint64_t delta) {
+  const std::string path = "check_xss_stream.bps";
+  bit_vector result(2 * instance.size() + 2, BV_FILL_ZERO);
+  {
+    bps_file_sink sink(path);
+    xss_real<strategy, ctz_builtin>::run_to_sink(
+        instance.data(), instance.size(), sink, delta, check_window_words);
+    sink.read(result.data(), 0, sink.words_written());
+  }
+  std::remove(path.c_str());
+  return result;
+}
+
+// batch of the instance, its first half and the instance again
+template <stack_strategy strategy, typename check_type, typename vec_type, typename result_type>
+static void check_xss_real_batch(const vec_type &instance,
+                                 const result_type &correct_result,
+                                 const uint64_t delta) {
+  vec_type half(instance.begin(), instance.begin() + instance.size() / 2);
+  half.push_back(0);
+  vec_type batch(instance);
+  batch.insert(batch.end(), half.begin(), half.end());
+  batch.insert(batch.end(), instance.begin(), instance.end());
+  const std::vector<uint64_t> offsets = {
+      0, instance.size(), instance.size() + half.size(), batch.size()};
+
+  const auto res = xss_real<strategy, ctz_builtin>::run_batch(batch.data(), offsets, delta, 2);
+  const auto correct_half = xss_isa_psv::run(half.data(), half.size());
+  for (uint64_t k = 0; k < 3; ++k) {
+    const auto &doc = (k == 1) ? half : instance;
+    const auto &correct = (k == 1) ? correct_half : correct_result;
+    bit_vector doc_res(2 * doc.size() + 2, BV_FILL_ZERO);
+    for (uint64_t i = 0; i < doc_res.size(); ++i)
+      doc_res.set(i, res.bps[res.offsets[k] + i]);
+    if (doc_res != correct)
+      check_type::check(doc, doc_res);
+  }
+}
+
+// the instance without its sentinels as a collection of three documents,
+// once as it is and once shifted such that its smallest character is 0
+// (the documents are compared with copies that have real sentinels)
+template <stack_strategy strategy, typename check_type, typename vec_type>
+static void check_xss_real_collection(const vec_type &instance,
+                                      const uint64_t delta) {
+  const uint64_t n = instance.size();
+  if (n < 3)
+    return;
+  const std::vector<uint64_t> offsets = {0, (n - 2) / 3, (n - 2) / 2, n - 2};
+  const vec_type text(instance.begin() + 1, instance.end() - 1);
+  vec_type shifted(text);
+  const auto min = *std::min_element(text.begin(), text.end());
+  for (auto &c : shifted)
+    c -= min;
+
+  for (const bool shift : {false, true}) {
+    const auto &collection = shift ? shifted : text;
+    const auto res = xss_real<strategy, ctz_builtin>::run_collection(collection.data(), offsets, delta, 2);
+    for (uint64_t k = 0; k < 3; ++k) {
+      vec_type doc(text.begin() + offsets[k], text.begin() + offsets[k + 1]);
+      doc.insert(doc.begin(), 0);
+      doc.push_back(0);
+      const auto correct = xss_isa_psv::run(doc.data(), doc.size());
+      bit_vector doc_res(2 * doc.size() + 2, BV_FILL_ZERO);
+      for (uint64_t i = 0; i < doc_res.size(); ++i)
+        doc_res.set(i, res.bps[res.offsets[k] + i]);
+      if (doc_res != correct)
+        check_type::check(doc, doc_res);
+    }
+  }
+}
+
+// checkpoints after every 7 positions, and resumes from checkpoints that are
+// taken from the correct bps (the bps prefix after processing all positions
+// before i ends right before the closing parentheses that precede node i);
+// a checkpoint of a different text of the same length must be ignored
+template <stack_strategy strategy, typename check_type, typename vec_type, typename result_type>
+static void check_xss_real_checkpoint(const vec_type &instance,
+                                      const result_type &correct_result,
+                                      const uint64_t delta) {
+  const std::string path = "check_xss_checkpoint.bin";
+  const uint64_t n = instance.size();
+  const uint64_t fingerprint =
+      xss_checkpoint_file::fingerprint(instance.data(), n);
+  auto res = xss_real<strategy, ctz_builtin>::run_checkpointed(
+      instance.data(), n, path, 7, delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+
+  for (const uint64_t i : {(uint64_t) 1, n / 3, n / 2, n - 2}) {
+    if (i < 1 || i + 2 > n)
+      continue;
+    // the opening parenthesis of node i is the (i + 2)-th one
+    uint64_t length = 0;
+    for (uint64_t ones = 0; ones < i + 2; ++length)
+      ones += correct_result[length] ? 1 : 0;
+    --length;
+    while (!correct_result[length - 1])
+      --length;
+    {
+      xss_checkpoint_file checkpoint(path, false);
+      checkpoint.save(n, fingerprint, i, correct_result, length);
+    }
+    res = xss_real<strategy, ctz_builtin>::resume_checkpointed(
+        instance.data(), n, path, 7, delta);
+    if (res != correct_result)
+      check_type::check(instance, res);
+
+    // claims that all positions are processed, but belongs to another text
+    {
+      xss_checkpoint_file checkpoint(path, false);
+      checkpoint.save(n, fingerprint + 1, n - 1, correct_result, length);
+    }
+    res = xss_real<strategy, ctz_builtin>::resume_checkpointed(
+        instance.data(), n, path, 7, delta);
+    if (res != correct_result)
+      check_type::check(instance, res);
+  }
+  std::remove(path.c_str());
+}
+
+// lyndon factorization from the streamed bps (with a tiny window) versus
+// duval's algorithm
+template <stack_strategy strategy, typename vec_type>
+static void check_xss_real_lyndon(const vec_type &instance,
+                                  const uint64_t delta) {
+  std::vector<uint64_t> correct, factors;
+  lyndon_factorization(instance.data() + 1, instance.size() - 2,
+                       [&](const uint64_t i) { correct.push_back(i + 1); });
+  xss_real<strategy, ctz_builtin>::run_lyndon_factorization(
+      instance.data(), instance.size(),
+      [&](const uint64_t i) { factors.push_back(i); }, delta,
+      check_window_words);
+  ASSERT_EQ(factors, correct);
+}
+
+// sparse pss and nss of every third position, and of an irregular set of
+// positions, versus the full arrays
+template <stack_strategy strategy, typename vec_type>
+static void check_xss_real_sparse(const vec_type &instance,
+                                  const uint64_t delta) {
+  const uint64_t n = instance.size();
+  const auto pss = xss_real<strategy, ctz_builtin>::run_pss_array(
+      instance.data(), n, delta);
+  const auto nss = xss_real<strategy, ctz_builtin>::run_nss_array(
+      instance.data(), n, delta);
+  std::vector<uint64_t> positions;
+  for (uint64_t i = 0; i < n; i += 1 + (i % 5))
+    positions.push_back(i);
+
+  for (const auto &sample : {xss_sample(n, 3), xss_sample(n, positions)}) {
+    const auto res = xss_real<strategy, ctz_builtin>::run_sparse(
+        instance.data(), n, sample, delta, check_window_words);
+    const auto res_bps = xss_bps<strategy, ctz_builtin>::run_sparse(
+        instance.data(), n, sample);
+    const auto res40 =
+        xss_real<strategy, ctz_builtin>::template run_sparse<uint40_t>(
+            instance.data(), n, sample, delta, check_window_words);
+    for (uint64_t k = 0; k < sample.size(); ++k) {
+      ASSERT_EQ(res.pss[k], pss[sample[k]]);
+      ASSERT_EQ(res.nss[k], nss[sample[k]]);
+      ASSERT_EQ(res_bps.pss[k], pss[sample[k]]);
+      ASSERT_EQ(res_bps.nss[k], nss[sample[k]]);
+      ASSERT_EQ(res40.pss[k], pss[sample[k]]);
+      ASSERT_EQ(res40.nss[k], nss[sample[k]]);
+    }
+  }
+
+  // (index types that cannot hold n are rejected)
+  if (n > 255) {
+    ASSERT_THROW(
+        (xss_real<strategy, ctz_builtin>::template run_sparse<uint8_t>(
+            instance.data(), n, xss_sample(n, 3), delta)),
+        std::invalid_argument);
+    ASSERT_THROW((xss_bps<strategy, ctz_builtin>::template run_sparse<uint8_t>(
+                     instance.data(), n, xss_sample(n, 3))),
+                 std::invalid_argument);
+  }
+}
+
+// 2 bit and 4 bit packed copies of the instance (if its alphabet is small
+// enough)
+template <stack_strategy strategy, typename check_type, typename vec_type,
+          typename result_type>
+static void check_xss_real_packed(const vec_type &instance,
+                                  const result_type &correct_result,
+                                  const uint64_t delta) {
+  const auto check_packed = [&](const auto &text) {
+    auto res = xss_real<strategy, ctz_builtin>::run_packed(text, delta);
+    if (res != correct_result)
+      check_type::check(instance, res);
+    res = xss_bps_lcp<strategy, ctz_builtin>::run_packed(text, delta);
+    if (res != correct_result)
+      check_type::check(instance, res);
+  };
+  try {
+    check_packed(packed_text<2>(instance.data(), instance.size()));
+  } catch (const std::invalid_argument &) {
+  }
+  try {
+    check_packed(packed_text<4>(instance.data(), instance.size()));
+  } catch (const std::invalid_argument &) {
+  }
+}
+
+// the bps that xss_real_inplace writes into a copy of the instance (with a
+// tiny window, such that the bps goes through the temporary file)
+template <stack_strategy strategy, typename check_type, typename vec_type,
+          typename result_type>
+static void check_xss_real_inplace(const vec_type &instance,
+                                   const result_type &correct_result,
+                                   const uint64_t delta) {
+  using algo = xss_real_inplace<strategy, ctz_builtin>;
+  const uint64_t n = instance.size();
+  std::vector<uint8_t> buffer(algo::template buffer_bytes<uint8_t>(n));
+  std::copy(instance.begin(), instance.end(), buffer.begin());
+  EXPECT_EQ(algo::run(buffer.data(), n, delta, check_window_words),
+            2 * n + 2);
+  const auto res = algo::get_bps(buffer.data(), n);
+  if (res != correct_result)
+    check_type::check(instance, res);
+}
+
+// lyndon arrays and bps of a few substrings (including the whole text) from
+// the bps of the instance, versus xss_real on a copy of each substring
+template <typename check_type, typename vec_type, typename result_type>
+static void check_xss_local_lyndon(const vec_type &instance,
+                                   const result_type &correct_result) {
+  using value_type = typename vec_type::value_type;
+  const uint64_t n = instance.size();
+  const bps_support_naive<bit_vector> support(correct_result);
+  auto lce = lce_naive<value_type>::get_lce(instance.data(), n);
+  const xss_local_lyndon<value_type, decltype(lce),
+                         bps_support_naive<bit_vector>>
+      local(instance.data(), lce, support);
+
+  for (const auto &window : {std::make_pair((uint64_t) 1, n - 1),
+                             std::make_pair((uint64_t) 1, n / 2),
+                             std::make_pair(n / 3, n - 1),
+                             std::make_pair(n / 4, 3 * n / 4)}) {
+    const uint64_t l = window.first, r = window.second;
+    if (l >= r)
+      continue;
+    vec_type copy(r - l + 2, 0);
+    std::copy(instance.begin() + l, instance.begin() + r, copy.begin() + 1);
+    const auto correct_lyndon =
+        xss_real<>::run_lyndon_array(copy.data(), copy.size());
+    const auto lyndon = local.lyndon(l, r);
+    for (uint64_t k = 0; k < lyndon.size(); ++k)
+      ASSERT_EQ(lyndon[k], correct_lyndon[k + 1]);
+    const auto bps = local.bps(l, r);
+    if (bps != xss_isa_psv::run(copy.data(), copy.size()))
+      check_type::check(copy, bps);
+  }
+}
+
+// online construction from a third of the instance, appending the rest in
+// chunks of one character and of n / 64 characters, versus xss_real on the
+// prefixes of the instance
+template <typename check_type, typename vec_type, typename result_type>
+static void check_xss_real_online(const vec_type &instance,
+                                  const result_type &correct_result) {
+  using value_type = typename vec_type::value_type;
+  const uint64_t n = instance.size();
+  const uint64_t start = 1 + (n - 2) / 3;
+  vec_type prefix(instance.begin(), instance.begin() + start);
+  prefix.push_back(instance.back());
+  xss_real_online<value_type> online(prefix.data(), prefix.size());
+
+  const uint64_t chunk = std::max(n / 64, (uint64_t) 2);
+  for (uint64_t i = start, k = 0; i < n - 1; ++k) {
+    const uint64_t count = std::min((k % 2 == 0) ? 1 : chunk, n - 1 - i);
+    online.append(instance.data() + i, count);
+    i += count;
+    ASSERT_EQ(online.size(), i + 1);
+    ASSERT_LE(online.frontier(), i);
+    if (k % 16 == 0) {
+      prefix.assign(instance.begin(), instance.begin() + i);
+      prefix.push_back(instance.back());
+      const auto &res = online.bps();
+      if (res != xss_real<>::run(prefix.data(), prefix.size()))
+        check_type::check(prefix, res);
+    }
+  }
+  if (online.bps() != correct_result)
+    check_type::check(instance, online.bps());
+}
+
+// every configuration of xss_real_auto, with the bps in memory and on disk,
+// and the configurations chosen for the estimated budgets
+template <typename check_type, typename vec_type, typename result_type>
+static void check_xss_real_auto(const vec_type &instance,
+                                const result_type &correct_result) {
+  using auto_type = xss_real_auto<ctz_builtin>;
+  const std::string path = "check_xss_auto.bps";
+  const uint64_t n = instance.size();
+  for (const bool on_disk : {false, true}) {
+    for (const auto &config : auto_type::configs(n, on_disk)) {
+      auto res = auto_type::run_config(instance.data(), n, config, path);
+      if (on_disk) {
+        res.bps = bit_vector(2 * n + 2, BV_FILL_ZERO);
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        const uint64_t words = std::fread(res.bps.data(), sizeof(uint64_t),
+                                          res.bps.data_size(), file);
+        std::fclose(file);
+        ASSERT_GE(words, div64(2 * n + 2 + 63));
+      }
+      if (res.bps != correct_result)
+        check_type::check(instance, res.bps);
+
+      if (!on_disk) {
+        const auto chosen = auto_type::choose(n, config.bytes, false);
+        ASSERT_LE(chosen.bytes, config.bytes);
+        res = auto_type::run(instance.data(), n, config.bytes);
+        if (res.bps != correct_result)
+          check_type::check(instance, res.bps);
+      }
+    }
+  }
+  std::remove(path.c_str());
+}
+
+// runs of the instance: every run must be a maximal repetition with at least
+// two periods, and short instances are compared with a naive computation
+// (a maximal repetition with period p is a run if no divisor of p is a period)
+template <typename vec_type>
+static void check_xss_runs(const vec_type &instance) {
+  const uint64_t n = instance.size();
+  const auto runs = xss_runs<>::run(instance.data(), n);
+  EXPECT_EQ(runs, (xss_runs<DYNAMIC, ctz_builtin, lce_naive>::run(instance.data(), n)));
+  for (uint64_t k = 0; k < runs.size(); ++k) {
+    const auto &r = runs[k];
+    ASSERT_GE(r.length, 2 * r.period);
+    ASSERT_GE(r.start, 1U);
+    ASSERT_LE(r.start + r.length, n - 1);
+    for (uint64_t i = r.start; i < r.start + r.length - r.period; ++i)
+      ASSERT_EQ(instance[i], instance[i + r.period]);
+    ASSERT_NE(instance[r.start - 1], instance[r.start - 1 + r.period]);
+    ASSERT_NE(instance[r.start + r.length], instance[r.start + r.length - r.period]);
+    if (k > 0) {
+      ASSERT_LE(runs[k - 1].start, r.start);
+    }
+  }
+  if (n > 1024)
+    return;
+
+  std::vector<xss_run> naive;
+  for (uint64_t p = 1; 2 * p <= n - 2; ++p) {
+    for (uint64_t i = 1; i + p < n - 1;) {
+      uint64_t length = 0;
+      while (i + length + p < n - 1 && instance[i + length] == instance[i + length + p])
+        ++length;
+      if (length >= p) {
+        bool smallest = true;
+        for (uint64_t d = 1; d < p && smallest; ++d) {
+          if (p % d != 0)
+            continue;
+          uint64_t k = i;
+          while (k + d < i + length + p && instance[k] == instance[k + d])
+            ++k;
+          smallest = (k + d < i + length + p);
+        }
+        if (smallest)
+          naive.push_back({i, length + p, p});
+      }
+      i += length + 1;
+    }
+  }
+  auto sorted = runs;
+  const auto less = [](const xss_run &a, const xss_run &b) {
+    return std::tie(a.start, a.period) < std::tie(b.start, b.period);
+  };
+  std::sort(sorted.begin(), sorted.end(), less);
+  std::sort(naive.begin(), naive.end(), less);
+  EXPECT_EQ(sorted, naive);
+}
 
 template <stack_strategy strategy, typename check_type, typename vec_type, typename result_type>
 static void check_all_xss_algos(const vec_type &instance, const result_type &correct_result) {
   constexpr uint64_t max_delta = (strategy != NAIVE) ? 32 : 1;
   for (uint64_t delta = 1; delta <= max_delta; delta = delta << 1) {
     auto res = xss_real<strategy, ctz_builtin>::run(instance.data(), instance.size(), delta);
+    if (res != correct_result)
+      check_type::check(instance, res);
+    res = xss_real<strategy, ctz_builtin>::run_parallel(instance.data(), instance.size(), delta, 4);
+    if (res != correct_result)
+      check_type::check(instance, res);
+    res = run_xss_real_to_callback<strategy>(instance, delta);
     if (res != correct_result)
       check_type::check(instance, res);
     res = xss_bps_lcp<strategy, ctz_builtin>::run(instance.data(), instance.size(), delta);
@@ -42,7 +456,43 @@ static void check_all_xss_algos(const vec_type &instance, const result_type &cor
       check_type::check(instance, res);
   }
 
-  auto res = xss_bps<strategy, ctz_builtin>::run(instance.data(), instance.size());
+  check_xss_real_batch<strategy, check_type>(instance, correct_result, max_delta);
+  check_xss_real_collection<strategy, check_type>(instance, max_delta);
+  check_xss_real_checkpoint<strategy, check_type>(instance, correct_result,
+                                                  max_delta);
+  check_xss_real_lyndon<strategy>(instance, max_delta);
+  check_xss_real_sparse<strategy>(instance, max_delta);
+  check_xss_real_packed<strategy, check_type>(instance, correct_result,
+                                              max_delta);
+  check_xss_real_inplace<strategy, check_type>(instance, correct_result,
+                                               max_delta);
+
+  auto res = run_xss_real_to_file<strategy>(instance, max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+  res = xss_real<strategy, ctz_builtin, lce_prezza1k>::run(instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+  res = xss_real<strategy, ctz_builtin, lce_herlez1k>::run(instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+  res = xss_real<strategy, ctz_builtin, lce_hybrid>::run(instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+  res = xss_bps_lcp<strategy, ctz_builtin, lce_prezza>::run(instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+
+  res = xss_real<strategy, ctz_debruijn, lce_naive, xss_no_stats, 1024>::run(
+      instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+  res = xss_real<strategy, ctz_builtin, lce_naive, xss_no_stats, 128, 64>::run(
+      instance.data(), instance.size(), max_delta);
+  if (res != correct_result)
+    check_type::check(instance, res);
+
+  res = xss_bps<strategy, ctz_builtin>::run(instance.data(), instance.size());
   if (res != correct_result)
     check_type::check(instance, res);
 }
@@ -58,4 +508,9 @@ static void check_all_xss_algos(const vec_type &instance) {
   check_all_xss_algos<STATIC, check_type> (instance, res0);
   check_all_xss_algos<DYNAMIC, check_type> (instance, res0);
   check_all_xss_algos<DYNAMIC_BUFFERED, check_type> (instance, res0);
+
+  check_xss_real_auto<check_type>(instance, res0);
+  check_xss_local_lyndon<check_type>(instance, res0);
+  check_xss_real_online<check_type>(instance, res0);
+  check_xss_runs(instance);
 }
\ No newline at end of file
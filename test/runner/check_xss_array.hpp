@@ -24,6 +24,71 @@
 #include <nss-real.hpp>
 #include <algorithms/nss_isa.hpp>
 #include <algorithms/pss_isa.hpp>
+#include <algorithms/xss_real.hpp>
+#include <algorithms/xss_real_nss.hpp>
+#include <util/integer_types.hpp>
+
+template <stack_strategy strategy, typename check_type, typename vec_type>
+static void check_xss_real_nss(const vec_type &instance) {
+  using algo = xss_real_nss<strategy, ctz_builtin>;
+  const auto bps = algo::run(instance.data(), instance.size());
+  check_type::check_nss(instance, algo::decode_nss(bps));
+  const auto pss_nss =
+      xss_real<strategy, ctz_builtin>::run_with_nss(instance.data(), instance.size());
+  check_type::check_nss(instance, pss_nss.second);
+  const auto pss_nss40 =
+      xss_real<strategy, ctz_builtin>::template run_with_nss<uint40_t>(instance.data(), instance.size());
+  check_type::check_nss(instance, pss_nss40.second);
+
+  using real = xss_real<strategy, ctz_builtin>;
+  check_type::check_pss(instance, real::template run_pss_array<uint32_t>(instance.data(), instance.size()));
+  check_type::check_nss(instance, real::template run_nss_array<uint40_t>(instance.data(), instance.size()));
+  auto lyndon = real::template run_lyndon_array<uint64_t>(instance.data(), instance.size());
+  for (uint64_t i = 0; i < lyndon.size(); ++i)
+    lyndon[i] += i;
+  check_type::check_nss(instance, lyndon);
+}
+
+// 32 bit entries if n < 2^32 and 40 bit entries otherwise, and explicit
+// index types that are too narrow for n are rejected
+template <typename vec_type>
+static void check_index_selection(const vec_type &instance) {
+  using real = xss_real<>;
+  const uint64_t n = instance.size();
+  ASSERT_FALSE(index_array::is_wide((1ULL << 32) - 1));
+  ASSERT_TRUE(index_array::is_wide(1ULL << 32));
+
+  const auto pss = real::run_pss_array(instance.data(), n);
+  const auto nss = real::run_nss_array(instance.data(), n);
+  const auto lyndon = real::run_lyndon_array(instance.data(), n);
+  const auto pss64 = real::run_pss_array<uint64_t>(instance.data(), n);
+  const auto nss64 = real::run_nss_array<uint64_t>(instance.data(), n);
+  ASSERT_FALSE(pss.wide());
+  ASSERT_EQ(pss.entry_bytes(), sizeof(uint32_t));
+  ASSERT_EQ(pss.size(), n);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_EQ(pss[i], pss64[i]);
+    ASSERT_EQ(nss[i], nss64[i]);
+    ASSERT_EQ(lyndon[i], nss64[i] - i);
+  }
+
+  index_array wide(2, 1ULL << 32);
+  ASSERT_TRUE(wide.wide());
+  ASSERT_EQ(wide.entry_bytes(), sizeof(uint40_t));
+  wide.set(1, (1ULL << 39) + 5);
+  ASSERT_EQ(wide[1], (1ULL << 39) + 5);
+  ASSERT_THROW(index_array(1, 1ULL << 40), std::invalid_argument);
+
+  // (the index type is checked before the text is read)
+  ASSERT_THROW(real::run_pss_array<uint32_t>(instance.data(), 1ULL << 32),
+               std::invalid_argument);
+  ASSERT_THROW(real::run_nss_array<uint32_t>(instance.data(), 1ULL << 32),
+               std::invalid_argument);
+  if (n > 255) {
+    ASSERT_THROW(real::run_lyndon_array<uint8_t>(instance.data(), n),
+                 std::invalid_argument);
+  }
+}
 
 template <typename check_type, typename vec_type>
 static void check_xss_array(const vec_type &instance) {
@@ -38,6 +103,11 @@ static void check_xss_array(const vec_type &instance) {
 
   using index_type = uint32_t;
 
+  check_xss_real_nss<NAIVE, check_type>(instance);
+  check_xss_real_nss<STATIC, check_type>(instance);
+  check_xss_real_nss<DYNAMIC, check_type>(instance);
+  check_xss_real_nss<DYNAMIC_BUFFERED, check_type>(instance);
+
   for (auto threshold : thresholds) {
     for (auto mode : modes) {
       const auto nss_vec = nss_real::nss(text, n, threshold, mode);
@@ -0,0 +1,108 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include <algorithms/xss_bps_lcp.hpp>
+#include <algorithms/xss_isa_psv.hpp>
+#include <algorithms/xss_real.hpp>
+#include <algorithms/xss_real_inplace.hpp>
+#include <algorithms/xss_runs.hpp>
+#include <data_structures/lce/lce_herlez.hpp>
+#include <data_structures/lce/lce_herlez1k.hpp>
+#include <data_structures/lce/lce_hybrid.hpp>
+#include <data_structures/lce/lce_naive.hpp>
+#include <data_structures/lce/lce_prezza.hpp>
+#include <data_structures/lce/lce_prezza1k.hpp>
+#include <random>
+
+// order preserving copy of the text, in which all characters but the
+// sentinels are larger than 255
+template <typename char_t, typename vec_type>
+static std::vector<char_t> widen_instance(const vec_type &instance) {
+  constexpr char_t factor = std::numeric_limits<char_t>::max() / 256;
+  std::vector<char_t> result(instance.size());
+  for (uint64_t i = 0; i < instance.size(); ++i)
+    result[i] = (instance[i] > 0) ? (instance[i] * factor + 256) : 0;
+  return result;
+}
+
+template <typename check_type, typename char_t, typename vec_type>
+static void check_xss_integer(const vec_type &instance) {
+  const auto wide = widen_instance<char_t>(instance);
+  const uint64_t n = wide.size();
+  const auto correct_result = xss_isa_psv::run(instance.data(), n);
+
+  // the tree of the wide text is the tree of the byte text
+  const auto check = [&](const auto &res) {
+    if (res != correct_result)
+      check_type::check(instance, res);
+  };
+  check(xss_real<NAIVE>::run(wide.data(), n, 0));
+  for (uint64_t delta = 1; delta <= 16; delta <<= 2) {
+    check(xss_real<STATIC>::run(wide.data(), n, delta));
+    check(xss_real<DYNAMIC>::run(wide.data(), n, delta));
+    check(xss_real<DYNAMIC_BUFFERED>::run(wide.data(), n, delta));
+    check(xss_bps_lcp<DYNAMIC_BUFFERED>::run(wide.data(), n, delta));
+  }
+  // (the in-place construction overwrites a copy of the text)
+  std::vector<char_t> buffer(xss_real_inplace<>::buffer_bytes<char_t>(n) /
+                             sizeof(char_t));
+  std::copy(wide.begin(), wide.end(), buffer.begin());
+  xss_real_inplace<>::run(buffer.data(), n);
+  check(xss_real_inplace<>::get_bps(buffer.data(), n));
+  // (the runs of the wide text are the runs of the byte text)
+  EXPECT_EQ(xss_runs<>::run(wide.data(), n),
+            xss_runs<>::run(instance.data(), n));
+
+  // compare the lce backends with naive lce on random pairs of suffixes
+  auto rk = lce_prezza<char_t>::get_lce(wide.data(), n);
+  auto rk1k = lce_prezza1k<char_t>::get_lce(wide.data(), n);
+  auto herlez1k = lce_herlez1k<char_t>::get_lce(wide.data(), n);
+  const auto hybrid = lce_hybrid<char_t>::get_lce(wide.data(), n);
+  // (herlez overwrites whole words of the text)
+  std::vector<char_t> copy(n + 8);
+  std::copy(wide.begin(), wide.end(), copy.begin());
+  auto herlez = lce_herlez<char_t>::get_suffix_compare(copy.data(), n);
+  const auto lce = lce_naive<char_t>::get_lce(wide.data());
+  const auto compare = lce_naive<char_t>::get_suffix_compare(wide.data());
+
+  std::mt19937 gen(n);
+  std::uniform_int_distribution<uint64_t> dis(1, n - 2);
+  for (uint64_t k = 0; k < std::min(n, (uint64_t) 1024); ++k) {
+    const uint64_t i = dis(gen);
+    const uint64_t j = dis(gen);
+    if (i == j)
+      continue;
+    const uint64_t correct_lce = lce(i, j);
+    EXPECT_EQ(rk(i, j), correct_lce);
+    EXPECT_EQ(rk1k(i, j), correct_lce);
+    EXPECT_EQ(herlez1k(i, j), correct_lce);
+    EXPECT_EQ(hybrid(i, j), correct_lce);
+    EXPECT_EQ(herlez(i, j), compare(i, j));
+  }
+}
+
+template <typename check_type, typename vec_type>
+static void check_xss_integer(const vec_type &instance) {
+  check_xss_integer<check_type, uint16_t>(instance);
+  check_xss_integer<check_type, uint32_t>(instance);
+  check_xss_integer<check_type, uint64_t>(instance);
+}
@@ -0,0 +1,160 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include <algorithms/duval.hpp>
+#include <algorithms/xss_real.hpp>
+#include <algorithms/xss_local.hpp>
+#include <algorithms/xss_real_nss.hpp>
+#include <data_structures/bit_vectors/bps_stream.hpp>
+#include <vector>
+
+// The algorithms take linear time, which these checks verify by counting the
+// characters that are compared by lce queries (this is deterministic, unlike
+// a measurement of the running time).
+
+// lce_naive that counts the compared characters (in a thread local counter)
+template <typename value_type = uint8_t>
+class lce_counting {
+public:
+  static uint64_t &characters() {
+    thread_local uint64_t characters = 0;
+    return characters;
+  }
+
+  struct lce {
+    const value_type *text_;
+    lce(const value_type *text) : text_(text) {}
+    uint64_t operator()(const uint64_t i, const uint64_t j,
+                        uint64_t lcp = 0) const {
+      const uint64_t start = lcp;
+      while (text_[i + lcp] == text_[j + lcp])
+        ++lcp;
+      characters() += lcp - start + 1;
+      return lcp;
+    }
+
+    uint64_t capped(const uint64_t i, const uint64_t j,
+                    const uint64_t limit) const {
+      uint64_t lcp = 0;
+      while (lcp < limit && text_[i + lcp] == text_[j + lcp])
+        ++lcp;
+      characters() += std::min(lcp + 1, limit);
+      return lcp;
+    }
+  };
+
+  static lce get_lce(const value_type *text, const uint64_t = 0) {
+    return lce(text);
+  }
+
+  static std::string to_string() {
+    return "LCE_COUNTING";
+  }
+};
+
+// (a^(period - 1) b)^* with sentinels
+static std::vector<uint8_t> periodic_instance(const uint64_t n,
+                                              const uint64_t period) {
+  std::vector<uint8_t> result(n);
+  for (uint64_t i = 1; i < n - 1; ++i)
+    result[i] = (i % period == 0) ? 'b' : 'a';
+  result[0] = result[n - 1] = 0;
+  return result;
+}
+
+// at most this many compared characters per text position
+constexpr static uint64_t linear_factor = 4;
+
+// streams the bps through a callback sink whose window is much shorter than
+// the period of the text
+template <stack_strategy strategy>
+static void check_linear_stream(const uint64_t n, const uint64_t period,
+                                const uint64_t window_words) {
+  const auto instance = periodic_instance(n, period);
+  const auto correct_result =
+      xss_real<strategy, ctz_builtin>::run(instance.data(), n);
+  bit_vector result(2 * n + 2, BV_FILL_ZERO);
+  uint64_t words = 0;
+  const auto callback = [&](const uint64_t *data, const uint64_t count) {
+    memcpy(result.data() + words, data, mul8(count));
+    words += count;
+  };
+  bps_callback_sink<decltype(callback)> sink(callback);
+  lce_counting<>::characters() = 0;
+  xss_real<strategy, ctz_builtin, lce_counting>::run_to_sink(
+      instance.data(), n, sink, 4, window_words);
+  ASSERT_LE(lce_counting<>::characters(), linear_factor * n);
+  ASSERT_TRUE(result == correct_result);
+}
+
+// lyndon factorization from a callback sink whose window is much shorter than
+// the period of the text (the factors are the occurrences of a^(period - 1) b
+// and the trailing run of a)
+template <stack_strategy strategy>
+static void check_linear_lyndon(const uint64_t n, const uint64_t period,
+                                const uint64_t window_words) {
+  const auto instance = periodic_instance(n, period);
+  std::vector<uint64_t> correct, factors;
+  lyndon_factorization(instance.data() + 1, n - 2,
+                       [&](const uint64_t i) { correct.push_back(i + 1); });
+  lce_counting<>::characters() = 0;
+  xss_real<strategy, ctz_builtin, lce_counting>::run_lyndon_factorization(
+      instance.data(), n, [&](const uint64_t i) { factors.push_back(i); }, 4,
+      window_words);
+  ASSERT_LE(lce_counting<>::characters(), linear_factor * n);
+  ASSERT_EQ(factors, correct);
+}
+
+// bps of the nss tree of a periodic text (e.g. b^n for period 1, and (ab)^n
+// for period 2)
+template <stack_strategy strategy>
+static void check_linear_nss_bps(const uint64_t n, const uint64_t period) {
+  using algo = xss_real_nss<strategy, ctz_builtin, lce_counting>;
+  const auto instance = periodic_instance(n, period);
+  lce_counting<>::characters() = 0;
+  const auto bps = algo::run(instance.data(), n);
+  ASSERT_LE(lce_counting<>::characters(), linear_factor * n);
+  const auto nss = algo::decode_nss(bps);
+  const auto correct =
+      xss_real<strategy, ctz_builtin>::template run_nss_array<uint64_t>(
+          instance.data(), n);
+  ASSERT_EQ(nss, correct);
+}
+
+// local lyndon array of a window inside of the run a^(n - 3) of a^(n - 3) b:
+// the lces in the whole text are as long as the run, but the queries of
+// xss_local_lyndon must not compare characters behind the window (so the
+// number of compared characters does not depend on n)
+static void check_local_lyndon(const uint64_t n, const uint64_t window,
+                               const uint64_t expected_characters) {
+  const auto instance = periodic_instance(n, n - 2);
+  const auto bps = xss_real<>::run(instance.data(), n);
+  const bps_support_sdsl<bit_vector> support(bps);
+  auto lce = lce_counting<>::get_lce(instance.data(), n);
+  const xss_local_lyndon<uint8_t, decltype(lce)> local(instance.data(), lce,
+                                                       support);
+  lce_counting<>::characters() = 0;
+  const auto lyndon = local.lyndon(n / 2, n / 2 + window);
+  ASSERT_EQ(lce_counting<>::characters(), expected_characters);
+  for (uint64_t k = 0; k < window; ++k)
+    ASSERT_EQ(lyndon[k], 1U);
+}
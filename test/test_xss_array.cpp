@@ -134,6 +134,13 @@ static void run_of_runs_test() {
   }
 }
 
+TEST(xss, index_selection) {
+  std::cout << "Testing the width of the arrays of xss_real." << std::endl;
+  for (const uint64_t n : {64, 1024}) {
+    check_index_selection(generate_test_ababc(n));
+  }
+}
+
 TEST(xss, hand_selected) {
   std::cout << "Testing XSS with hand selected instances." << std::endl;
   hand_selected_test(manual_test_instances());
@@ -0,0 +1,75 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "runner/check_xss_integer.hpp"
+#include "util/test_check.hpp"
+#include "util/test_gen.hpp"
+#include "util/test_manual.hpp"
+#include "util/test_lookahead.hpp"
+
+constexpr static uint64_t min_n = 64;
+constexpr static uint64_t max_n = 16ULL * 1024;
+
+using check_type = nss_check<true, true>;
+
+template <typename instance_collection>
+static void hand_selected_test(instance_collection &&instances) {
+  std::cout << "Number of instances: " << instances.size() << std::endl;
+  for (auto instance : instances) {
+    check_xss_integer<check_type>(instance);
+    std::reverse(instance.begin(), instance.end());
+    check_xss_integer<check_type>(instance);
+  }
+}
+
+TEST(xss_integer, hand_selected) {
+  std::cout << "Testing XSS with integer alphabets (hand selected instances)."
+            << std::endl;
+  hand_selected_test(manual_test_instances());
+}
+
+TEST(xss_integer, lookahead) {
+  std::cout << "Testing XSS with integer alphabets (cover all lookahead cases)."
+            << std::endl;
+  hand_selected_test(manual_test_instances_lookahead(128));
+}
+
+TEST(xss_integer, run_of_runs) {
+  std::cout << "Testing XSS with integer alphabets (run of runs)." << std::endl;
+  for (uint64_t n = min_n; n <= max_n; n *= 4) {
+    auto instance = generate_test_run_of_runs(n, 3);
+    check_xss_integer<check_type>(instance);
+    std::reverse(instance.begin(), instance.end());
+    check_xss_integer<check_type>(instance);
+  }
+}
+
+TEST(xss_integer, random) {
+  std::cout << "Testing XSS with integer alphabets (random instances)."
+            << std::endl;
+  for (uint64_t sigma = 2; sigma <= 128; sigma *= 4) {
+    for (uint64_t n = min_n; n <= max_n; n *= 4) {
+      auto instance = generate_test_random(n, sigma);
+      check_xss_integer<check_type>(instance);
+    }
+  }
+}
@@ -0,0 +1,57 @@
+//  Copyright (c) 2019 Jonas Ellert
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "runner/check_xss_linear.hpp"
+
+constexpr static uint64_t min_n = 50000;
+constexpr static uint64_t max_n = 400000;
+
+TEST(xss_linear, stream) {
+  for (uint64_t n = min_n; n <= max_n; n *= 2) {
+    check_linear_stream<DYNAMIC_BUFFERED>(n, 1000, 16);
+    check_linear_stream<STATIC>(n, 1000, 16);
+    check_linear_stream<DYNAMIC_BUFFERED>(n, 3, 16);
+  }
+}
+
+TEST(xss_linear, lyndon_factorization) {
+  for (uint64_t n = min_n; n <= max_n; n *= 2) {
+    check_linear_lyndon<DYNAMIC_BUFFERED>(n, 1000, 16);
+    check_linear_lyndon<DYNAMIC>(n, 1000, 16);
+  }
+}
+
+TEST(xss_linear, nss_bps) {
+  for (uint64_t n = min_n; n <= max_n; n *= 2) {
+    for (const uint64_t period : {1, 2, 1000}) {
+      check_linear_nss_bps<DYNAMIC_BUFFERED>(n, period);
+      check_linear_nss_bps<STATIC>(n, period);
+    }
+  }
+}
+
+TEST(xss_linear, local_lyndon) {
+  // each position compares the window suffix behind it with itself
+  constexpr uint64_t window = 1000;
+  for (uint64_t n = min_n; n <= max_n; n *= 2)
+    check_local_lyndon(n, window, window * (window - 1) / 2);
+}